@@ -6,7 +6,14 @@
 #include <boost/bimap.hpp>
 #include <string>
 #include <any>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <mutex>
 #include <utility>
+#include <unistd.h>
 
 inline boost::bimap<int, std::string> FSMStringMap;
 
@@ -18,6 +25,11 @@ public:
         FSMStringMap.insert({state, state_string});
     }
 
+    virtual ~BaseState() = default;
+
+    // Heavy resources (policies, deploy.yaml, motion data). May run on the FSM loader thread.
+    virtual void load() {}
+
     virtual void enter() {}
 
     virtual void pre_run() {}
@@ -30,8 +42,61 @@ public:
     int getState() {return state_; }
     bool isState(int state) { return state_ == state; }
     std::vector<std::pair<std::function<bool()>, int>> registered_checks;
+
+    // Run load() once. Concurrent callers block until the first one finishes; a failed load is rethrown.
+    void ensure_loaded()
+    {
+        std::unique_lock<std::mutex> lock(load_mtx_);
+        load_cv_.wait(lock, [this]{ return load_status_ != LoadStatus::Loading; });
+        if (load_status_ == LoadStatus::Ready) return;
+        if (load_status_ == LoadStatus::Failed) std::rethrow_exception(load_error_);
+
+        load_status_ = LoadStatus::Loading;
+        lock.unlock();
+
+        auto t0 = std::chrono::steady_clock::now();
+        const double rss0 = resident_mb();
+        std::exception_ptr error;
+        try {
+            load();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        load_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        load_rss_mb_ = resident_mb() - rss0;
+        load_status_ = error ? LoadStatus::Failed : LoadStatus::Ready;
+        load_error_ = error;
+        load_cv_.notify_all();
+        if (error) std::rethrow_exception(error);
+    }
+
+    bool is_loaded() { std::lock_guard<std::mutex> lock(load_mtx_); return load_status_ == LoadStatus::Ready; }
+    bool load_failed() { std::lock_guard<std::mutex> lock(load_mtx_); return load_status_ == LoadStatus::Failed; }
+    double load_time() { std::lock_guard<std::mutex> lock(load_mtx_); return load_time_; }
+    // Growth of the process RSS during load(); states load one at a time, so this is the state's own share.
+    double load_rss_mb() { std::lock_guard<std::mutex> lock(load_mtx_); return load_rss_mb_; }
+
+    static double resident_mb()
+    {
+        long size = 0, resident = 0;
+        std::ifstream statm("/proc/self/statm");
+        statm >> size >> resident;
+        return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+    }
+
 private:
+    enum class LoadStatus { Pending, Loading, Ready, Failed };
+
     int state_;
+
+    std::mutex load_mtx_;
+    std::condition_variable load_cv_;
+    LoadStatus load_status_ = LoadStatus::Pending;
+    std::exception_ptr load_error_;
+    double load_time_ = 0.0;
+    double load_rss_mb_ = 0.0;
 };
 
 using FsmFactory = std::function<std::shared_ptr<BaseState>(int, std::string)>;
@@ -5,8 +5,14 @@
 
 #include <unitree/common/thread/recurrent_thread.hpp>
 #include "BaseState.h"
+#include "isaaclab/algorithms/inference_runtime.h"
 #include <spdlog/spdlog.h>
 #include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <set>
+#include <thread>
 
 class CtrlFSM
 {
@@ -21,6 +27,7 @@ public:
     CtrlFSM(YAML::Node cfg)
     {
         auto fsms = cfg["_"]; // enabled FSMs
+        background_loading_ = cfg["background_loading"] ? cfg["background_loading"].as<bool>() : false;
 
         // register FSM string map; used for state transition
         for (auto it = fsms.begin(); it != fsms.end(); ++it)
@@ -43,17 +50,33 @@ public:
             auto state_instance = fsm_class->second(id, fsm_name);
             add(state_instance);
         }
+
+        if (!background_loading_) {
+            for (auto & state : states) {
+                state->ensure_loaded();
+                spdlog::info("FSM: State_{} loaded in {:.3f}s (+{:.1f} MB)", state->getStateString(), state->load_time(), state->load_rss_mb());
+            }
+            spdlog::info("FSM: resident memory {:.1f} MB after loading", BaseState::resident_mb());
+        }
     }
 
     void start() 
     {
         // Start From State_Passive
         currentState = states[0];
+        currentState->ensure_loaded();
         currentState->enter();
 
+        if (background_loading_) {
+            load_order_ = transition_priority_();
+            loader_thread_ = std::thread(&CtrlFSM::load_all_, this);
+        }
+
         fsm_thread_ = std::make_shared<unitree::common::RecurrentThread>(
             "FSM", 0, this->dt * 1e6, &CtrlFSM::run_, this);
-        spdlog::info("FSM: Start {}", currentState->getStateString());
+        spdlog::info("FSM: Start {} ({:.3f}s after init, {} loading)", currentState->getStateString(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - created_at_).count(),
+            background_loading_ ? "background" : "eager");
     }
 
     void add(std::shared_ptr<BaseState> state)
@@ -72,6 +95,10 @@ public:
     
     ~CtrlFSM()
     {
+        loader_running_ = false;
+        if (loader_thread_.joinable()) {
+            loader_thread_.join();
+        }
         states.clear();
     }
 
@@ -96,22 +123,116 @@ private:
             }
         }
 
-        if(nextStateMode != 0 && !currentState->isState(nextStateMode))
+        if(nextStateMode == 0 || currentState->isState(nextStateMode)) return;
+
+        std::shared_ptr<BaseState> nextState;
+        for(auto & state : states)
         {
-            for(auto & state : states)
+            if(state->isState(nextStateMode))
             {
-                if(state->isState(nextStateMode))
+                nextState = state;
+                break;
+            }
+        }
+        if(!nextState) return;
+
+        // Only switch on the tick the check fires; a target still loading is moved up the queue, not queued
+        if(!nextState->is_loaded())
+        {
+            if(nextState->load_failed())
+            {
+                if(failed_state_ != nextStateMode) {
+                    spdlog::error("FSM: State_{} failed to load, ignoring transition", nextState->getStateString());
+                }
+                failed_state_ = nextStateMode;
+            }
+            else if(urgent_state_.exchange(nextStateMode) != nextStateMode)
+            {
+                spdlog::warn("FSM: State_{} is not ready yet, press again once it is loaded", nextState->getStateString());
+            }
+            return;
+        }
+
+        spdlog::info("FSM: Change state from {} to {}", currentState->getStateString(), nextState->getStateString());
+        currentState->exit();
+        currentState = nextState;
+        urgent_state_ = 0;
+        failed_state_ = 0;
+        currentState->enter();
+    }
+
+    // Breadth-first over the transition graph from the initial state, unreachable states last.
+    std::vector<std::shared_ptr<BaseState>> transition_priority_()
+    {
+        std::vector<std::shared_ptr<BaseState>> order;
+        std::set<int> visited;
+        std::deque<std::shared_ptr<BaseState>> queue{states[0]};
+        visited.insert(states[0]->getState());
+        while (!queue.empty())
+        {
+            auto state = queue.front();
+            queue.pop_front();
+            order.push_back(state);
+            for (auto & check : state->registered_checks)
+            {
+                if (visited.count(check.second)) continue;
+                for (auto & s : states)
                 {
-                    spdlog::info("FSM: Change state from {} to {}", currentState->getStateString(), state->getStateString());
-                    currentState->exit();
-                    currentState = state;
-                    currentState->enter();
-                    break;
+                    if (s->isState(check.second))
+                    {
+                        visited.insert(check.second);
+                        queue.push_back(s);
+                        break;
+                    }
                 }
             }
         }
+        for (auto & state : states)
+        {
+            if (!visited.count(state->getState())) order.push_back(state);
+        }
+        return order;
+    }
+
+    void load_all_()
+    {
+        isaaclab::InferenceRuntime::BackgroundScope background; // no autotune benchmarks next to the control loop
+        const auto t0 = std::chrono::steady_clock::now();
+        std::size_t loaded = 0, failed = 0;
+        while (loader_running_)
+        {
+            // A requested transition target jumps the queue
+            std::shared_ptr<BaseState> next;
+            const int urgent = urgent_state_.load();
+            for (auto & state : load_order_)
+            {
+                if (state->is_loaded() || state->load_failed()) continue;
+                if (!next || state->isState(urgent)) next = state;
+                if (state->isState(urgent)) break;
+            }
+            if (!next) break;
+
+            try {
+                next->ensure_loaded();
+                ++loaded;
+                spdlog::info("FSM: State_{} loaded in {:.3f}s (+{:.1f} MB)", next->getStateString(), next->load_time(), next->load_rss_mb());
+            } catch (const std::exception& e) {
+                ++failed;
+                spdlog::error("FSM: State_{} failed to load: {}", next->getStateString(), e.what());
+            }
+        }
+        spdlog::info("FSM: Background loading finished in {:.3f}s ({} loaded, {} failed, resident memory {:.1f} MB)",
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(), loaded, failed, BaseState::resident_mb());
     }
 
     std::shared_ptr<BaseState> currentState;
     unitree::common::RecurrentThreadPtr fsm_thread_;
+
+    bool background_loading_ = false;
+    const std::chrono::steady_clock::time_point created_at_ = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<BaseState>> load_order_;
+    std::thread loader_thread_;
+    std::atomic<bool> loader_running_{true};
+    std::atomic<int> urgent_state_{0};
+    int failed_state_ = 0; // last failed target reported, FSM thread only
 };
\ No newline at end of file
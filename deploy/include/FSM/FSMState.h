@@ -14,6 +14,11 @@ public:
     {
         spdlog::info("Initializing State_{} ...", state_string);
 
+        // Private copy for load(), which may run off the FSM thread while others read param::config.
+        if (auto node = param::config["FSM"][state_string]) {
+            state_cfg_ = YAML::Clone(node);
+        }
+
         auto transitions = param::config["FSM"][state_string]["transitions"];
 
         if(transitions)
@@ -56,6 +61,7 @@ public:
     void pre_run()
     {
         lowstate->update();
+        state_hub->update();
         if(keyboard) keyboard->update();
     }
 
@@ -66,5 +72,9 @@ public:
 
     static std::unique_ptr<LowCmd_t> lowcmd;
     static std::shared_ptr<LowState_t> lowstate;
+    static std::shared_ptr<RobotStateHub_t> state_hub; // decoded lowstate, read this instead of lowstate->msg_
     static std::shared_ptr<Keyboard> keyboard;
+
+protected:
+    YAML::Node state_cfg_;
 };
\ No newline at end of file
@@ -38,9 +38,10 @@ public:
 
     void run()
     {
-        for(int i(0); i < lowcmd->msg_.motor_cmd().size(); ++i)
+        const auto state = state_hub->read();
+        for(int i(0); i < std::min<int>(lowcmd->msg_.motor_cmd().size(), state.num_motors); ++i)
         {
-            lowcmd->msg_.motor_cmd()[i].q() = lowstate->msg_.motor_state()[i].q();
+            lowcmd->msg_.motor_cmd()[i].q() = state.q[i];
         }
     }
 };
@@ -13,6 +13,8 @@ class State_RLBase : public FSMState
 {
 public:
     State_RLBase(int state_mode, std::string state_string);
+
+    void load();
     
     void enter()
     {
@@ -35,7 +37,8 @@ public:
         policy_thread_running = true;
         policy_thread = std::thread([this]{
             using clock = std::chrono::high_resolution_clock;
-            const std::chrono::duration<double> desiredDuration(env->step_dt);
+            // With action chunking, one inference covers several policy steps
+            const std::chrono::duration<double> desiredDuration(env->step_dt * env->action_manager->chunk_execute());
             const auto dt = std::chrono::duration_cast<clock::duration>(desiredDuration);
 
             // Initialize timing
@@ -70,6 +73,7 @@ private:
     std::chrono::duration<double> logging_dt{0.02};
     std::chrono::steady_clock::time_point last_log_time;
     std::chrono::steady_clock::time_point start_time;
+    std::vector<float> processed_action_; // run() buffer
 
     std::thread policy_thread;
     bool policy_thread_running = false;
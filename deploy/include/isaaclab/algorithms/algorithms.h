@@ -4,6 +4,11 @@
 #pragma once
 
 #include "onnxruntime_cxx_api.h"
+#include "isaaclab/algorithms/inference_runtime.h"
+#include "isaaclab/algorithms/quantization.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <mutex>
 #include <map>
 #include <unordered_map>
@@ -15,9 +20,26 @@ namespace isaaclab
 class Algorithms
 {
 public:
-    virtual std::vector<float> act(std::unordered_map<std::string, std::vector<float>> obs) = 0;
-    virtual std::map<std::string, std::vector<float>> forward(std::unordered_map<std::string, std::vector<float>> obs) { return {}; }
-    
+    virtual ~Algorithms() = default;
+
+    virtual std::vector<float> act(const std::unordered_map<std::string, std::vector<float>>& obs) = 0;
+    virtual std::map<std::string, std::vector<float>> forward(const std::unordered_map<std::string, std::vector<float>>& /*obs*/) { return {}; }
+
+    // Run inference and write the requested outputs into `results`.
+    // `results` is reused across calls, so backends that keep persistent buffers can refresh it without allocating.
+    virtual void forward_into(
+        const std::unordered_map<std::string, std::vector<float>>& obs,
+        std::map<std::string, std::vector<float>>& results)
+    {
+        results = forward(obs);
+    }
+
+    // Clear any state carried between steps (recurrent policies). Called from ManagerBasedRLEnv::reset.
+    virtual void reset() {}
+
+    // Restrict the outputs read back by forward_into(). Empty means all outputs.
+    void set_requested_outputs(std::vector<std::string> names) { requested_outputs_ = std::move(names); }
+
     std::vector<float> get_action()
     {
         std::lock_guard<std::mutex> lock(act_mtx_);
@@ -26,35 +48,198 @@ public:
     
     std::vector<float> action;
 protected:
+    bool is_output_requested(const std::string& name) const
+    {
+        return requested_outputs_.empty() ||
+            std::find(requested_outputs_.begin(), requested_outputs_.end(), name) != requested_outputs_.end();
+    }
+
     std::mutex act_mtx_;
+    std::vector<std::string> requested_outputs_;
 };
 
 class OrtRunner : public Algorithms
 {
 public:
-    OrtRunner(std::string model_path)
+    // io_binding: bind input/output buffers once and reuse them on every step (see forward_into).
+    // quantization: optionally run a gated INT8 variant of the model (see quantization.h).
+    // Recurrent state pairs (`h_in` -> `h_out`, `memory_in_0` -> `memory_out_0`, ...) are detected from the
+    // model and fed back internally; they always run with io_binding.
+    // Symbolic dimensions (batch, sequence length, ...) are resolved from the observation sizes on each call,
+    // see _resolve_shape().
+    // session_config: execution provider and threading of this session (see session_config.h).
+    OrtRunner(std::string model_path, bool io_binding = false, const QuantizationConfig& quantization = {},
+              const SessionConfig& session_config = {})
+    : io_binding_(io_binding)
     {
         // Init Model
-        env = Ort::Env(ORT_LOGGING_LEVEL_WARNING, "onnx_model");
-        session_options.SetGraphOptimizationLevel(ORT_ENABLE_EXTENDED);
+        std::string providers;
+        session = InferenceRuntime::instance().create_session(model_path, session_options, "OrtRunner", session_config, &providers);
+        session = quantize_session(std::move(session), model_path, "OrtRunner", quantization, session_config, providers);
+        _init();
+    }
+
+    // Run an already created session as is, e.g. a reference that must bypass InferenceRuntime's cache,
+    // autotuning, sharing and profiling.
+    OrtRunner(std::shared_ptr<Ort::Session> prebuilt, bool io_binding = false)
+    : session(std::move(prebuilt)), io_binding_(io_binding)
+    {
+        _init();
+    }
+
+    void reset() override
+    {
+        for (auto& state : states_) {
+            for (auto& buffer : state.buffers) std::fill(buffer.begin(), buffer.end(), 0.0f);
+        }
+        parity_ = 0;
+    }
+
+    std::vector<float> act(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        auto results = forward(obs);
+        if (results.count("actions")) {
+            return results["actions"];
+        } else if (!results.empty()) {
+            return results.begin()->second;
+        }
+        return {};
+    }
+
+    std::map<std::string, std::vector<float>> forward(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        if (io_binding_) {
+            std::map<std::string, std::vector<float>> results;
+            forward_into(obs, results);
+            return results;
+        }
 
-        session = std::make_unique<Ort::Session>(env, model_path.c_str(), session_options);
+        auto results = _run(obs);
+        if(results.count("actions")) {
+             std::lock_guard<std::mutex> lock(act_mtx_);
+             action = results["actions"];
+        }
+        
+        return results;
+    }
 
+    // With io_binding enabled, observations are copied straight into the bound input memory and only the
+    // requested outputs are read back. Once `results` holds its keys, a step performs no heap allocation.
+    // A change in observation size (another batch size or sequence length) rebinds the buffers first.
+    void forward_into(
+        const std::unordered_map<std::string, std::vector<float>>& obs,
+        std::map<std::string, std::vector<float>>& results) override
+    {
+        if (!io_binding_) {
+            results = forward(obs);
+            return;
+        }
+
+        bool rebind = false;
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            if (_is_state_input(i)) continue;
+            auto it = obs.find(input_names_strings[i]);
+            if (it == obs.end()) {
+                throw std::runtime_error("Input name '" + input_names_strings[i] + "' not found in observations.");
+            }
+            rebind |= it->second.size() != input_buffers_[i].size();
+        }
+        if (rebind) _bind_buffers(&obs);
+
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            if (_is_state_input(i)) continue;
+            const auto& src = obs.at(input_names_strings[i]);
+            std::copy(src.begin(), src.end(), input_buffers_[i].begin());
+        }
+
+        // The step writes the next state into the other buffer of each pair; flipping the parity feeds it back.
+        session->Run(run_options_, *bindings_[parity_]);
+        InferenceRuntime::instance().profile_step(*session);
+        if (!states_.empty()) parity_ ^= 1;
+
+        for (size_t i = 0; i < output_names_strings.size(); ++i)
+        {
+            if (_is_state_output(i)) continue;
+            if (i != action_index && !is_output_requested(output_names_strings[i])) continue;
+            const auto& src = output_buffers_[i];
+            results[output_names_strings[i]].assign(src.begin(), src.end());
+        }
+
+        if (action_index < output_buffers_.size() && output_names_strings[action_index] == "actions") {
+            std::lock_guard<std::mutex> lock(act_mtx_);
+            action.assign(output_buffers_[action_index].begin(), output_buffers_[action_index].end());
+        }
+    }
+
+    // Evaluate several observation sets in one Run by stacking them along the leading (batch) dimension, which
+    // every input must declare symbolic. Results come back split per set; `action` is left untouched.
+    std::vector<std::map<std::string, std::vector<float>>> forward_batch(
+        const std::vector<std::unordered_map<std::string, std::vector<float>>>& batch)
+    {
+        if (batch.empty()) return {};
+        if (!states_.empty()) {
+            throw std::runtime_error("OrtRunner: forward_batch does not support recurrent models.");
+        }
+
+        std::unordered_map<std::string, std::vector<float>> stacked;
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            const auto& name = input_names_strings[i];
+            if (model_input_shapes_[i].empty() || model_input_shapes_[i][0] >= 0) {
+                throw std::runtime_error("OrtRunner: input '" + name + "' has no symbolic batch dimension.");
+            }
+            auto& dst = stacked[name];
+            for (const auto& obs : batch)
+            {
+                auto it = obs.find(name);
+                if (it == obs.end()) {
+                    throw std::runtime_error("Input name '" + name + "' not found in observations.");
+                }
+                if (it->second.size() != batch.front().at(name).size()) {
+                    throw std::runtime_error("OrtRunner: input '" + name + "' differs in size across the batch.");
+                }
+                dst.insert(dst.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        auto results = _run(stacked);
+        std::vector<std::map<std::string, std::vector<float>>> split(batch.size());
+        for (const auto& [name, values] : results)
+        {
+            if (values.size() % batch.size() != 0) {
+                throw std::runtime_error("OrtRunner: output '" + name + "' is not batched.");
+            }
+            const size_t n = values.size() / batch.size();
+            for (size_t b = 0; b < batch.size(); ++b) {
+                split[b][name].assign(values.begin() + b * n, values.begin() + (b + 1) * n);
+            }
+        }
+        return split;
+    }
+
+private:
+    // Read the inputs, outputs and recurrent state pairs of `session` and bind buffers.
+    void _init()
+    {
         // Dynamic input detection
         size_t num_inputs = session->GetInputCount();
         for (size_t i = 0; i < num_inputs; ++i) {
             Ort::TypeInfo input_type = session->GetInputTypeInfo(i);
-            input_shapes.push_back(input_type.GetTensorTypeAndShapeInfo().GetShape());
+            auto info = input_type.GetTensorTypeAndShapeInfo();
+            model_input_shapes_.push_back(info.GetShape());
+            input_dim_params_.push_back(_dim_params(info));
             auto input_name = session->GetInputNameAllocated(i, allocator);
             input_names_strings.push_back(input_name.get());
         }
         for (const auto& name : input_names_strings) {
             input_names.push_back(name.c_str());
         }
-        for (const auto& shape : input_shapes) {
-            size_t size = 1;
-            for (const auto& dim : shape) size *= dim;
-            input_sizes.push_back(size);
+        input_shapes = model_input_shapes_;
+        for (auto& shape : input_shapes) {
+            input_sizes.push_back(_default_count(shape));
+            for (auto& dim : shape) dim = std::max<int64_t>(dim, 1);
         }
 
         // Dynamic output detection
@@ -65,42 +250,162 @@ public:
         for(size_t i = 0; i < num_outputs; i++) {
             auto name = session->GetOutputNameAllocated(i, allocator);
             output_names_strings.push_back(name.get());
+            Ort::TypeInfo output_type = session->GetOutputTypeInfo(i);
+            auto info = output_type.GetTensorTypeAndShapeInfo();
+            model_output_shapes_.push_back(info.GetShape());
+            output_dim_params_.push_back(_dim_params(info));
         }
+        output_shapes = model_output_shapes_;
         
         for(size_t i = 0; i < num_outputs; i++) {
             output_names.push_back(output_names_strings[i].c_str());
         }
 
-        // Find "actions" output shape for compatibility
+        // Find "actions" output shape for compatibility. Symbolic dims count as 1 until the first step.
         bool action_found = false;
         for(size_t i=0; i<num_outputs; i++) {
              if(output_names_strings[i] == "actions") {
-                 auto output_type = session->GetOutputTypeInfo(i);
-                 output_shape = output_type.GetTensorTypeAndShapeInfo().GetShape();
-                 action.resize(output_shape[1]);
+                 output_shape = output_shapes[i];
+                 action.resize(_default_count(output_shape));
+                 action_index = i;
                  action_found = true;
                  break;
              }
         }
         if (!action_found && num_outputs > 0) {
-             auto output_type = session->GetOutputTypeInfo(0);
-             output_shape = output_type.GetTensorTypeAndShapeInfo().GetShape();
-             action.resize(output_shape[1]);
+             output_shape = output_shapes[0];
+             action.resize(_default_count(output_shape));
+        }
+
+        // Recurrent state: an input whose name has an `_in` token with a matching `_out` output
+        for (size_t i = 0; i < input_names_strings.size(); ++i) {
+            const auto out_name = _recurrent_output_name(input_names_strings[i]);
+            auto it = std::find(output_names_strings.begin(), output_names_strings.end(), out_name);
+            if (out_name.empty() || it == output_names_strings.end()) continue;
+            RecurrentState state;
+            state.input_index = i;
+            state.output_index = static_cast<size_t>(it - output_names_strings.begin());
+            states_.push_back(std::move(state));
+            spdlog::info("OrtRunner: recurrent state {} -> {}", input_names_strings[i], out_name);
+        }
+        if (!states_.empty()) {
+            io_binding_ = true;
+        }
+
+        if (io_binding_) {
+            _bind_buffers(nullptr);
         }
     }
+    struct RecurrentState
+    {
+        size_t input_index = 0;
+        size_t output_index = 0;
+        std::array<std::vector<float>, 2> buffers{};
+    };
 
-    std::vector<float> act(std::unordered_map<std::string, std::vector<float>> obs) override
+    // `h_in` -> `h_out`, `memory_in_0` -> `memory_out_0`; empty if the name has no `_in` token.
+    static std::string _recurrent_output_name(const std::string& name)
     {
-        auto results = forward(obs);
-        if (results.count("actions")) {
-            return results["actions"];
-        } else if (!results.empty()) {
-            return results.begin()->second;
+        const auto pos = name.rfind("_in");
+        if (pos == std::string::npos) return "";
+        const size_t end = pos + 3;
+        if (end < name.size() && name[end] != '_' && name[end] != '.' && !std::isdigit(static_cast<unsigned char>(name[end]))) {
+            return "";
         }
-        return {};
+        return name.substr(0, pos) + "_out" + name.substr(end);
+    }
+
+    bool _is_state_input(size_t i) const
+    {
+        return std::any_of(states_.begin(), states_.end(), [i](const RecurrentState& s) { return s.input_index == i; });
+    }
+
+    bool _is_state_output(size_t i) const
+    {
+        return std::any_of(states_.begin(), states_.end(), [i](const RecurrentState& s) { return s.output_index == i; });
+    }
+
+    template <typename Info>
+    static std::vector<std::string> _dim_params(const Info& info)
+    {
+        std::vector<const char*> params(info.GetDimensionsCount(), nullptr);
+        if (!params.empty()) info.GetSymbolicDimensions(params.data(), params.size());
+        std::vector<std::string> names;
+        for (const char* p : params) names.emplace_back(p ? p : "");
+        return names;
+    }
+
+    // Element count with symbolic dimensions taken as 1.
+    static size_t _default_count(const std::vector<int64_t>& shape)
+    {
+        size_t size = 1;
+        for (auto dim : shape) size *= static_cast<size_t>(std::max<int64_t>(dim, 1));
+        return size;
+    }
+
+    /**
+     * Concrete shape of a model input that holds `count` values. Symbolic dims already bound in `dims` (by their
+     * dim_param name, e.g. `batch`) take that value; the first remaining one absorbs the rest of `count` and any
+     * others become 1. Newly resolved names are added to `dims`.
+     */
+    std::vector<int64_t> _resolve_shape(size_t i, size_t count, std::map<std::string, int64_t>& dims) const
+    {
+        const auto& model = model_input_shapes_[i];
+        const auto& params = input_dim_params_[i];
+        std::vector<int64_t> shape = model;
+        int64_t known = 1;
+        int free_dim = -1;
+        for (size_t d = 0; d < shape.size(); ++d)
+        {
+            if (shape[d] < 0) {
+                auto it = params[d].empty() ? dims.end() : dims.find(params[d]);
+                if (it != dims.end()) shape[d] = it->second;
+                else if (free_dim < 0) { free_dim = static_cast<int>(d); continue; }
+                else shape[d] = 1;
+            }
+            known *= shape[d];
+        }
+        if (free_dim >= 0 && known > 0 && count % known == 0 && count >= static_cast<size_t>(known)) {
+            shape[free_dim] = static_cast<int64_t>(count) / known;
+        }
+        if (free_dim < 0 ? static_cast<size_t>(known) != count : shape[free_dim] < 0) {
+            throw std::runtime_error("Input '" + input_names_strings[i] + "' expects " + _shape_str(model)
+                + ", got " + std::to_string(count) + " values.");
+        }
+        for (size_t d = 0; d < shape.size(); ++d) {
+            if (model[d] < 0 && !params[d].empty()) dims.emplace(params[d], shape[d]);
+        }
+        return shape;
+    }
+
+    // Shape of a state input or an output: named symbolic dims from `dims`, an unnamed leading dim from `batch`,
+    // anything else 1. Returns false if some dim had to be guessed.
+    static bool _bound_shape(
+        const std::vector<int64_t>& model, const std::vector<std::string>& params,
+        const std::map<std::string, int64_t>& dims, int64_t batch, std::vector<int64_t>& shape)
+    {
+        bool exact = true;
+        shape = model;
+        for (size_t d = 0; d < shape.size(); ++d)
+        {
+            if (shape[d] >= 0) continue;
+            auto it = params[d].empty() ? dims.end() : dims.find(params[d]);
+            if (it != dims.end()) shape[d] = it->second;
+            else if (d == 0) shape[d] = batch;
+            else { shape[d] = 1; exact = false; }
+        }
+        return exact;
     }
 
-    std::map<std::string, std::vector<float>> forward(std::unordered_map<std::string, std::vector<float>> obs) override
+    static std::string _shape_str(const std::vector<int64_t>& shape)
+    {
+        std::string s = "[";
+        for (size_t d = 0; d < shape.size(); ++d) s += (d ? ", " : "") + (shape[d] < 0 ? std::string("?") : std::to_string(shape[d]));
+        return s + "]";
+    }
+
+    // Plain Run with per-call tensors; shapes are resolved from the observation sizes.
+    std::map<std::string, std::vector<float>> _run(const std::unordered_map<std::string, std::vector<float>>& obs)
     {
         auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
 
@@ -112,15 +417,18 @@ public:
         }
 
         // Create input tensors in model input order
+        std::map<std::string, int64_t> dims;
         std::vector<Ort::Value> input_tensors;
         for(size_t i = 0; i < input_names.size(); ++i)
         {
             auto& input_data = obs.at(input_names_strings[i]);
-            auto input_tensor = Ort::Value::CreateTensor<float>(memory_info, input_data.data(), input_sizes[i], input_shapes[i].data(), input_shapes[i].size());
+            const auto shape = _resolve_shape(i, input_data.size(), dims);
+            auto input_tensor = Ort::Value::CreateTensor<float>(memory_info, const_cast<float*>(input_data.data()), input_data.size(), shape.data(), shape.size());
             input_tensors.push_back(std::move(input_tensor));
         }
 
         auto output_tensors = session->Run(Ort::RunOptions{nullptr}, input_names.data(), input_tensors.data(), input_tensors.size(), output_names.data(), output_names.size());
+        InferenceRuntime::instance().profile_step(*session);
         
         std::map<std::string, std::vector<float>> results;
         for(size_t i=0; i<output_tensors.size(); i++) {
@@ -133,19 +441,129 @@ public:
             std::vector<float> val(floatarr, floatarr + count);
             results[output_names_strings[i]] = val;
         }
-        
-        if(results.count("actions")) {
-             std::lock_guard<std::mutex> lock(act_mtx_);
-             action = results["actions"];
-        }
-        
         return results;
     }
 
-private:
-    Ort::Env env;
+    /**
+     * Allocate input/output buffers and bind them to the session, sized for `obs` (model defaults with symbolic
+     * dims as 1 when null). Called once at construction and again whenever the observation sizes change.
+     * Recurrent models get two bindings that differ only in which state buffer is read and which is written.
+     */
+    void _bind_buffers(const std::unordered_map<std::string, std::vector<float>>* obs)
+    {
+        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+
+        // Resolve every input before touching the buffers, so a bad size leaves the current binding intact.
+        std::map<std::string, int64_t> dims;
+        std::vector<std::vector<int64_t>> shapes(input_names_strings.size());
+        int64_t batch = 0;
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            if (_is_state_input(i)) continue;
+            const size_t count = obs ? obs->at(input_names_strings[i]).size() : _default_count(model_input_shapes_[i]);
+            shapes[i] = _resolve_shape(i, count, dims);
+            if (batch == 0 && !model_input_shapes_[i].empty() && model_input_shapes_[i][0] < 0) batch = shapes[i][0];
+        }
+        if (batch == 0) batch = 1;
+
+        input_buffers_.resize(input_names_strings.size());
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            if (_is_state_input(i)) continue;
+            input_shapes[i] = shapes[i];
+            input_sizes[i] = static_cast<int64_t>(_default_count(shapes[i]));
+            input_buffers_[i].assign(input_sizes[i], 0.0f);
+        }
+
+        bool exact = true;
+        for (size_t i = 0; i < output_names_strings.size(); ++i) {
+            exact &= _bound_shape(model_output_shapes_[i], output_dim_params_[i], dims, batch, output_shapes[i]);
+        }
+        bool states_reset = false;
+        for (auto& state : states_)
+        {
+            const size_t i = state.input_index;
+            _bound_shape(model_input_shapes_[i], input_dim_params_[i], dims, batch, input_shapes[i]);
+            input_sizes[i] = static_cast<int64_t>(_default_count(input_shapes[i]));
+            if (state.buffers[0].size() != static_cast<size_t>(input_sizes[i])) {
+                states_reset |= !state.buffers[0].empty();
+                for (auto& buffer : state.buffers) buffer.assign(input_sizes[i], 0.0f);
+            }
+        }
+        if (states_reset) parity_ = 0;
+        if (!exact) _probe_output_shapes(memory_info);
+
+        output_buffers_.resize(output_names_strings.size());
+        for (size_t i = 0; i < output_names_strings.size(); ++i)
+        {
+            if (!_is_state_output(i)) output_buffers_[i].assign(_default_count(output_shapes[i]), 0.0f);
+        }
+        for (auto& state : states_)
+        {
+            if (static_cast<size_t>(input_sizes[state.input_index]) != _default_count(output_shapes[state.output_index])) {
+                throw std::runtime_error("OrtRunner: recurrent state " + input_names_strings[state.input_index] + " and its output differ in size.");
+            }
+        }
+
+        input_values_.clear();
+        output_values_.clear();
+        const int num_bindings = states_.empty() ? 1 : 2;
+        for (int p = 0; p < num_bindings; ++p)
+        {
+            bindings_[p] = std::make_unique<Ort::IoBinding>(*session);
+            for (size_t i = 0; i < input_names_strings.size(); ++i)
+            {
+                float* data = input_buffers_[i].data();
+                for (auto& state : states_) {
+                    if (state.input_index == i) data = state.buffers[p].data();
+                }
+                input_values_.push_back(Ort::Value::CreateTensor<float>(
+                    memory_info, data, input_sizes[i], input_shapes[i].data(), input_shapes[i].size()));
+                bindings_[p]->BindInput(input_names[i], input_values_.back());
+            }
+            for (size_t i = 0; i < output_names_strings.size(); ++i)
+            {
+                float* data = output_buffers_[i].data();
+                size_t size = output_buffers_[i].size();
+                for (auto& state : states_) {
+                    if (state.output_index == i) { data = state.buffers[1 - p].data(); size = state.buffers[1 - p].size(); }
+                }
+                output_values_.push_back(Ort::Value::CreateTensor<float>(
+                    memory_info, data, size, output_shapes[i].data(), output_shapes[i].size()));
+                bindings_[p]->BindOutput(output_names[i], output_values_.back());
+            }
+        }
+
+        if (obs) {
+            std::string shapes;
+            for (size_t i = 0; i < input_names_strings.size(); ++i) {
+                shapes += (i ? ", " : "") + input_names_strings[i] + _shape_str(input_shapes[i]);
+            }
+            spdlog::info("OrtRunner: rebound buffers for {}", shapes);
+        }
+    }
+
+    // Output dims that cannot be derived from the inputs are read from one run on the (zeroed) input buffers.
+    void _probe_output_shapes(const Ort::MemoryInfo& memory_info)
+    {
+        std::vector<Ort::Value> inputs;
+        for (size_t i = 0; i < input_names_strings.size(); ++i)
+        {
+            float* data = input_buffers_[i].data();
+            for (auto& state : states_) {
+                if (state.input_index == i) data = state.buffers[0].data();
+            }
+            inputs.push_back(Ort::Value::CreateTensor<float>(
+                memory_info, data, input_sizes[i], input_shapes[i].data(), input_shapes[i].size()));
+        }
+        auto outputs = session->Run(Ort::RunOptions{nullptr}, input_names.data(), inputs.data(), inputs.size(), output_names.data(), output_names.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            output_shapes[i] = outputs[i].GetTensorTypeAndShapeInfo().GetShape();
+        }
+    }
+
     Ort::SessionOptions session_options;
-    std::unique_ptr<Ort::Session> session;
+    std::shared_ptr<Ort::Session> session;
     Ort::AllocatorWithDefaultOptions allocator;
 
     std::vector<const char*> input_names;
@@ -153,9 +571,29 @@ private:
     std::vector<const char*> output_names;
     std::vector<std::string> output_names_strings;
 
+    // Shapes as declared by the model (-1: symbolic dim, named in *_dim_params_) and as currently resolved.
+    std::vector<std::vector<int64_t>> model_input_shapes_;
+    std::vector<std::vector<int64_t>> model_output_shapes_;
+    std::vector<std::vector<std::string>> input_dim_params_;
+    std::vector<std::vector<std::string>> output_dim_params_;
     std::vector<std::vector<int64_t>> input_shapes;
     std::vector<int64_t> input_sizes;
+    std::vector<std::vector<int64_t>> output_shapes;
     std::vector<int64_t> output_shape;
+    size_t action_index = 0;
+
+    // Persistent binding mode
+    bool io_binding_ = false;
+    Ort::RunOptions run_options_;
+    std::array<std::unique_ptr<Ort::IoBinding>, 2> bindings_;
+    std::vector<std::vector<float>> input_buffers_;
+    std::vector<std::vector<float>> output_buffers_;
+    std::vector<Ort::Value> input_values_;
+    std::vector<Ort::Value> output_values_;
+
+    // Recurrent state double buffers
+    std::vector<RecurrentState> states_;
+    int parity_ = 0;
 };
 
 };
\ No newline at end of file
@@ -0,0 +1,288 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "onnxruntime_cxx_api.h"
+#include "isaaclab/algorithms/session_config.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Startup search for the fastest thread / spinning / optimization-level setting of one CPU session.
+ *
+ * Every candidate session runs `iterations` steps on synthetic inputs of the model's exact shapes (symbolic
+ * dims = 1); the candidate with the lowest p99 wins, the session's own config (usually the shared pools)
+ * being one of them. The choice is stored in <model dir>/autotune.yaml under the model's content hash and
+ * the host (CPU model, core count, ORT version), so later boots on the same board reuse it without
+ * benchmarking and a new model file or another board tunes again.
+ */
+class SessionAutotuner
+{
+public:
+    using SessionFactory = std::function<std::unique_ptr<Ort::Session>(const SessionConfig&)>;
+
+    struct Result
+    {
+        SessionConfig config;
+        double p50_us = 0.0;
+        double p99_us = 0.0;
+        bool reused = false;
+    };
+
+    SessionAutotuner(std::filesystem::path model_path, std::string model_hash, std::string owner, int iterations = 200)
+    : model_path_(std::move(model_path)), model_hash_(std::move(model_hash)), owner_(std::move(owner)),
+      iterations_(std::max(iterations, 20))
+    {
+    }
+
+    // Stored choice for `base` on this host, without benchmarking.
+    std::optional<Result> lookup(const SessionConfig& base) const
+    {
+        Result result;
+        result.config = base;
+        if (!_load(_key(), result)) return std::nullopt;
+        result.reused = true;
+        return result;
+    }
+
+    // Tuned copy of `base`. `make_session` builds an uncached session for a candidate config.
+    Result tune(const SessionConfig& base, const SessionFactory& make_session) const
+    {
+        if (auto stored = lookup(base)) return *stored;
+        const std::string key = _key();
+        Result result;
+        result.config = base;
+
+        std::vector<SessionConfig> candidates = {base};
+        const int cores = std::max(1u, std::thread::hardware_concurrency());
+        for (int threads : {1, 2, 4}) {
+            if (threads > cores) continue;
+            for (int spinning : {0, 1}) {
+                for (auto level : {ORT_ENABLE_BASIC, ORT_ENABLE_EXTENDED, ORT_ENABLE_ALL}) {
+                    SessionConfig candidate = base;
+                    candidate.intra_op_num_threads = threads;
+                    candidate.allow_spinning = spinning;
+                    candidate.opt_level = level;
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        bool found = false;
+        for (const auto& candidate : candidates) {
+            Result measured;
+            try {
+                auto session = make_session(candidate);
+                _measure(*session, measured);
+            } catch (const std::exception& e) {
+                spdlog::warn("SessionAutotuner: [{}] candidate {} failed: {}", owner_, describe(candidate), e.what());
+                continue;
+            }
+            if (!found || measured.p99_us < result.p99_us) {
+                result.config = candidate;
+                result.p50_us = measured.p50_us;
+                result.p99_us = measured.p99_us;
+                found = true;
+            }
+        }
+        if (!found) throw std::runtime_error("no candidate could be benchmarked");
+
+        spdlog::info("SessionAutotuner: [{}] tried {} configs in {:.1f}s", owner_, candidates.size(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        _store(key, result);
+        return result;
+    }
+
+    static std::string describe(const SessionConfig& c)
+    {
+        if (!c.per_session_threads()) return std::string("shared pools, opt=") + SessionConfig::opt_level_name(c.opt_level);
+        return "intra=" + std::to_string(c.intra_op_num_threads) + ", spinning=" + (c.allow_spinning == 1 ? "on" : "off")
+            + ", opt=" + SessionConfig::opt_level_name(c.opt_level);
+    }
+
+    // CPU model, core count and ORT version: the parts of a board that change the winner.
+    static std::string host_id()
+    {
+        std::string cpu = "unknown";
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        for (std::string line; std::getline(cpuinfo, line);) {
+            if (line.rfind("model name", 0) == 0 || line.rfind("Model", 0) == 0 || line.rfind("Hardware", 0) == 0) {
+                const auto colon = line.find(':');
+                if (colon == std::string::npos) continue;
+                cpu = line.substr(line.find_first_not_of(" \t", colon + 1));
+                break;
+            }
+        }
+        return cpu + " x" + std::to_string(std::thread::hardware_concurrency())
+            + ", ort " + OrtGetApiBase()->GetVersionString();
+    }
+
+    static std::string host_hash()
+    {
+        const std::string id = host_id();
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : id) { hash ^= c; hash *= 1099511628211ull; }
+        std::ostringstream ss;
+        ss << std::hex << std::setw(8) << std::setfill('0') << static_cast<uint32_t>(hash ^ (hash >> 32));
+        return ss.str();
+    }
+
+private:
+    std::string _key() const { return model_path_.stem().string() + "." + model_hash_ + "." + host_hash(); }
+
+    std::filesystem::path _store_path() const { return model_path_.parent_path() / "autotune.yaml"; }
+
+    void _measure(Ort::Session& session, Result& result) const
+    {
+        Ort::AllocatorWithDefaultOptions allocator;
+        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+        std::mt19937 rng(0);
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+
+        std::vector<std::string> input_names, output_names;
+        std::vector<std::vector<int64_t>> shapes;
+        std::vector<std::vector<float>> float_data;
+        std::vector<std::vector<int64_t>> int_data;
+        std::vector<Ort::Value> inputs;
+        const size_t num_inputs = session.GetInputCount();
+        float_data.reserve(num_inputs);
+        int_data.reserve(num_inputs);
+        shapes.reserve(num_inputs);
+        for (size_t i = 0; i < num_inputs; ++i) {
+            auto info = session.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo();
+            auto& shape = shapes.emplace_back(info.GetShape());
+            size_t size = 1;
+            for (auto& d : shape) { if (d < 0) d = 1; size *= d; }
+            input_names.push_back(session.GetInputNameAllocated(i, allocator).get());
+            if (info.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+                auto& data = float_data.emplace_back(size);
+                for (auto& v : data) v = dist(rng);
+                inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, data.data(), size, shape.data(), shape.size()));
+            } else if (info.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64) {
+                auto& data = int_data.emplace_back(size, 0);
+                inputs.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, data.data(), size, shape.data(), shape.size()));
+            } else {
+                throw std::runtime_error("input '" + input_names.back() + "' is neither float nor int64");
+            }
+        }
+        for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+            output_names.push_back(session.GetOutputNameAllocated(i, allocator).get());
+        }
+        std::vector<const char*> in_ptrs, out_ptrs;
+        for (const auto& n : input_names) in_ptrs.push_back(n.c_str());
+        for (const auto& n : output_names) out_ptrs.push_back(n.c_str());
+
+        auto run = [&] {
+            session.Run(Ort::RunOptions{nullptr}, in_ptrs.data(), inputs.data(), inputs.size(), out_ptrs.data(), out_ptrs.size());
+        };
+        for (int i = 0; i < 10; ++i) run();
+        std::vector<double> samples(iterations_);
+        for (auto& s : samples) {
+            const auto t0 = std::chrono::steady_clock::now();
+            run();
+            s = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        }
+        std::sort(samples.begin(), samples.end());
+        result.p50_us = samples[samples.size() / 2];
+        result.p99_us = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    }
+
+    bool _load(const std::string& key, Result& result) const
+    {
+        std::lock_guard<std::mutex> lock(_file_mutex());
+        if (!std::filesystem::exists(_store_path())) return false;
+        try {
+            const YAML::Node entry = YAML::LoadFile(_store_path().string())[key];
+            if (!entry) return false;
+            result.config.intra_op_num_threads = entry["intra_op_threads"].as<int>();
+            result.config.allow_spinning = entry["allow_spinning"].IsNull() ? -1 : (entry["allow_spinning"].as<bool>() ? 1 : 0);
+            result.config.opt_level = SessionConfig::opt_level_from(entry["graph_optimization"].as<std::string>());
+            result.p50_us = entry["p50_us"].as<double>();
+            result.p99_us = entry["p99_us"].as<double>();
+            return true;
+        } catch (const std::exception& e) {
+            spdlog::warn("SessionAutotuner: [{}] ignoring unreadable {}: {}", owner_, _store_path().string(), e.what());
+            return false;
+        }
+    }
+
+    void _store(const std::string& key, const Result& result) const
+    {
+        namespace fs = std::filesystem;
+        std::lock_guard<std::mutex> lock(_file_mutex());
+        YAML::Node root;
+        try {
+            if (fs::exists(_store_path())) root = YAML::LoadFile(_store_path().string());
+        } catch (const std::exception&) {
+            root = YAML::Node();
+        }
+
+        // Drop results of a previous version of this model file on this host
+        const std::string prefix = model_path_.stem().string() + ".";
+        const std::string suffix = "." + host_hash();
+        YAML::Node kept(YAML::NodeType::Map);
+        for (const auto& kv : root) {
+            const auto name = kv.first.as<std::string>();
+            const bool same_model = name.rfind(prefix, 0) == 0 && name.size() > suffix.size()
+                && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+            if (!same_model) kept[name] = kv.second;
+        }
+
+        YAML::Node entry;
+        entry["model"] = model_path_.filename().string();
+        entry["host"] = host_id();
+        entry["intra_op_threads"] = result.config.intra_op_num_threads;
+        if (result.config.allow_spinning >= 0) entry["allow_spinning"] = result.config.allow_spinning == 1;
+        else entry["allow_spinning"] = YAML::Node(YAML::NodeType::Null);
+        entry["graph_optimization"] = SessionConfig::opt_level_name(result.config.opt_level);
+        entry["p50_us"] = result.p50_us;
+        entry["p99_us"] = result.p99_us;
+        kept[key] = entry;
+
+        std::error_code ec;
+        const fs::path tmp_path = _store_path().string() + ".tmp";
+        {
+            std::ofstream out(tmp_path);
+            out << kept;
+            if (!out) {
+                spdlog::warn("SessionAutotuner: [{}] cannot write {}", owner_, tmp_path.string());
+                return;
+            }
+        }
+        fs::rename(tmp_path, _store_path(), ec);
+        if (ec) spdlog::warn("SessionAutotuner: [{}] cannot write {}: {}", owner_, _store_path().string(), ec.message());
+    }
+
+    static std::mutex& _file_mutex()
+    {
+        static std::mutex mtx;
+        return mtx;
+    }
+
+    std::filesystem::path model_path_;
+    std::string model_hash_;
+    std::string owner_;
+    int iterations_;
+};
+
+};
@@ -0,0 +1,292 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "isaaclab/algorithms/policy_factory.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <set>
+
+namespace isaaclab
+{
+
+/**
+ * Composite policy declared in deploy.yaml: models and tensor ops run in order over named tensors.
+ *
+ * inference_graph:
+ *   stages:
+ *     - name: base
+ *       model: exported/base_policy.onnx        # relative to policy_dir; policy_backend / io_binding /
+ *       inputs: {obs: policy}                   #   quantization may be set per stage
+ *       outputs: {actions: base_action}         # model tensor -> graph tensor
+ *     - {name: residual_obs, concat: [policy, base_action], output: residual_in}
+ *     - {name: residual, model: exported/residual_policy.onnx, inputs: {obs: residual_in},
+ *        outputs: {actions: residual_action}, every: 2}
+ *     - {name: mix, sum: [base_action, residual_action], weights: [1.0, 0.5], output: actions}
+ *   outputs: [actions]                          # default [actions]
+ *
+ * Ops: `model`, `concat` (list of tensors), `gather` ({input, indices}: out[i] = in[indices[i]], for
+ * permutations), `slice` ({input, start, length}), `sum` (list of tensors, optional `weights`),
+ * `history` ({input, length, fill}: the last `length` values of a tensor, oldest first, kept in a ring buffer).
+ *
+ * `history` lets a long-history policy be exported split in two: a per-frame encoder that only sees the
+ * newest frame, and a head over the window of cached embeddings, so each step encodes one frame:
+ *     - {name: encoder, model: exported/frame_encoder.onnx, inputs: {obs: frame}, outputs: {embedding: emb}}
+ *     - {name: window, history: {input: emb, length: 15}, output: emb_history}
+ *     - {name: head, model: exported/history_head.onnx, inputs: {history: emb_history, obs: policy}, outputs: {actions: actions}}
+ * After a reset the window is filled with the first frame (`fill: first`, as ObservationManager) or zeros.
+ * `every: N` runs a stage on every N-th step only and keeps its last outputs in between.
+ * Tensors not produced by an earlier stage are read from the observations (group names).
+ *
+ * Every tensor keeps its buffer across steps, so after the first step a forward pass does not allocate.
+ */
+class InferenceGraph : public Algorithms
+{
+public:
+    InferenceGraph(const YAML::Node& cfg, const std::filesystem::path& policy_dir, const PolicyOptions& opts)
+    {
+        if (!cfg["stages"] || !cfg["stages"].IsSequence()) {
+            throw std::runtime_error("InferenceGraph: 'stages' must be a list.");
+        }
+        output_names_ = cfg["outputs"] ? cfg["outputs"].as<std::vector<std::string>>() : std::vector<std::string>{"actions"};
+
+        std::set<std::string> produced;
+        for (const auto& node : cfg["stages"]) {
+            _add_stage(node, policy_dir, opts, produced);
+        }
+        for (const auto& name : output_names_) {
+            if (!produced.count(name)) throw std::runtime_error("InferenceGraph: output '" + name + "' is not produced by any stage.");
+            outputs_.push_back(&tensors_[name]);
+        }
+
+        std::string summary;
+        for (const auto& stage : stages_) {
+            summary += (summary.empty() ? "" : " -> ") + stage.name + (stage.every > 1 ? "/" + std::to_string(stage.every) : "");
+        }
+        std::string inputs;
+        for (const auto& name : input_names_) inputs += (inputs.empty() ? "" : ", ") + name;
+        spdlog::info("InferenceGraph: {} (inputs: {})", summary, inputs);
+    }
+
+    std::vector<float> act(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        forward_into(obs, act_results_);
+        return get_action();
+    }
+
+    std::map<std::string, std::vector<float>> forward(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        std::map<std::string, std::vector<float>> results;
+        forward_into(obs, results);
+        return results;
+    }
+
+    void forward_into(
+        const std::unordered_map<std::string, std::vector<float>>& obs,
+        std::map<std::string, std::vector<float>>& results) override
+    {
+        for (size_t i = 0; i < input_names_.size(); ++i) {
+            auto it = obs.find(input_names_[i]);
+            if (it == obs.end()) {
+                throw std::runtime_error("InferenceGraph: input '" + input_names_[i] + "' not found in observations.");
+            }
+            inputs_[i]->assign(it->second.begin(), it->second.end());
+        }
+
+        for (auto& stage : stages_) {
+            if (step_ % stage.every == 0) stage.run();
+        }
+        ++step_;
+
+        for (size_t i = 0; i < output_names_.size(); ++i) {
+            if (output_names_[i] != "actions" && !is_output_requested(output_names_[i])) continue;
+            results[output_names_[i]].assign(outputs_[i]->begin(), outputs_[i]->end());
+        }
+        auto it = results.find("actions");
+        if (it != results.end()) {
+            std::lock_guard<std::mutex> lock(act_mtx_);
+            action.assign(it->second.begin(), it->second.end());
+        }
+    }
+
+    void reset() override
+    {
+        step_ = 0;
+        for (auto& stage : stages_) {
+            if (stage.model) stage.model->reset();
+            if (stage.reset) stage.reset();
+        }
+    }
+
+private:
+    struct Stage
+    {
+        std::string name;
+        int every = 1;
+        std::function<void()> run;
+        std::function<void()> reset;
+
+        // model stages
+        std::unique_ptr<Algorithms> model;
+        std::unordered_map<std::string, std::vector<float>> feed;
+        std::map<std::string, std::vector<float>> results;
+    };
+
+    // Buffer of a tensor read by a stage; unknown tensors become graph inputs.
+    std::vector<float>* _read(const std::string& name, const std::set<std::string>& produced)
+    {
+        if (!produced.count(name) && std::find(input_names_.begin(), input_names_.end(), name) == input_names_.end()) {
+            input_names_.push_back(name);
+            inputs_.push_back(&tensors_[name]);
+        }
+        return &tensors_[name];
+    }
+
+    std::vector<float>* _write(const std::string& name, std::set<std::string>& produced)
+    {
+        if (std::find(input_names_.begin(), input_names_.end(), name) != input_names_.end()) {
+            throw std::runtime_error("InferenceGraph: tensor '" + name + "' is read before it is written.");
+        }
+        produced.insert(name);
+        return &tensors_[name];
+    }
+
+    void _add_stage(const YAML::Node& node, const std::filesystem::path& policy_dir, const PolicyOptions& opts, std::set<std::string>& produced)
+    {
+        Stage& stage = stages_.emplace_back();
+        stage.name = node["name"] ? node["name"].as<std::string>() : "stage" + std::to_string(stages_.size() - 1);
+        stage.every = node["every"] ? std::max(1, node["every"].as<int>()) : 1;
+        auto error = [&](const std::string& msg) { return std::runtime_error("InferenceGraph: stage '" + stage.name + "': " + msg); };
+
+        if (node["model"]) {
+            if (!node["inputs"] || !node["outputs"]) throw error("model stages need 'inputs' and 'outputs' maps.");
+            PolicyOptions stage_opts = opts;
+            stage_opts.apply(node, policy_dir);
+            stage.model = make_policy(policy_dir / node["model"].as<std::string>(), stage_opts);
+
+            std::vector<std::pair<std::vector<float>*, std::vector<float>*>> feeds;
+            for (const auto& kv : node["inputs"]) {
+                feeds.emplace_back(_read(kv.second.as<std::string>(), produced), &stage.feed[kv.first.as<std::string>()]);
+            }
+            std::vector<std::pair<std::string, std::vector<float>*>> fetches;
+            std::vector<std::string> requested;
+            for (const auto& kv : node["outputs"]) {
+                fetches.emplace_back(kv.first.as<std::string>(), _write(kv.second.as<std::string>(), produced));
+                requested.push_back(kv.first.as<std::string>());
+            }
+            stage.model->set_requested_outputs(requested);
+
+            stage.run = [&stage, feeds, fetches, error] {
+                for (const auto& [src, dst] : feeds) dst->assign(src->begin(), src->end());
+                stage.model->forward_into(stage.feed, stage.results);
+                for (const auto& [name, dst] : fetches) {
+                    auto it = stage.results.find(name);
+                    if (it == stage.results.end()) throw error("model has no output '" + name + "'.");
+                    dst->assign(it->second.begin(), it->second.end());
+                }
+            };
+            return;
+        }
+
+        if (!node["output"]) throw error("missing 'output'.");
+        const auto out_name = node["output"].as<std::string>();
+
+        if (node["concat"]) {
+            std::vector<std::vector<float>*> srcs;
+            for (const auto& name : node["concat"].as<std::vector<std::string>>()) srcs.push_back(_read(name, produced));
+            auto* dst = _write(out_name, produced);
+            stage.run = [srcs, dst] {
+                dst->clear();
+                for (const auto* src : srcs) dst->insert(dst->end(), src->begin(), src->end());
+            };
+        } else if (node["gather"]) {
+            auto* src = _read(node["gather"]["input"].as<std::string>(), produced);
+            auto* dst = _write(out_name, produced);
+            const auto indices = node["gather"]["indices"].as<std::vector<size_t>>();
+            dst->resize(indices.size());
+            stage.run = [src, dst, indices, error] {
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    if (indices[i] >= src->size()) throw error("gather index out of range.");
+                    (*dst)[i] = (*src)[indices[i]];
+                }
+            };
+        } else if (node["slice"]) {
+            auto* src = _read(node["slice"]["input"].as<std::string>(), produced);
+            auto* dst = _write(out_name, produced);
+            const auto start = node["slice"]["start"] ? node["slice"]["start"].as<size_t>() : 0;
+            const auto length = node["slice"]["length"].as<size_t>();
+            stage.run = [src, dst, start, length, error] {
+                if (start + length > src->size()) throw error("slice out of range.");
+                dst->assign(src->begin() + start, src->begin() + start + length);
+            };
+        } else if (node["sum"]) {
+            std::vector<std::vector<float>*> srcs;
+            for (const auto& name : node["sum"].as<std::vector<std::string>>()) srcs.push_back(_read(name, produced));
+            const auto weights = node["weights"] ? node["weights"].as<std::vector<float>>() : std::vector<float>(srcs.size(), 1.0f);
+            if (weights.size() != srcs.size()) throw error("'weights' must match 'sum'.");
+            auto* dst = _write(out_name, produced);
+            stage.run = [srcs, weights, dst, error] {
+                dst->assign(srcs.front()->size(), 0.0f);
+                for (size_t k = 0; k < srcs.size(); ++k) {
+                    if (srcs[k]->size() != dst->size()) throw error("summed tensors differ in size.");
+                    for (size_t i = 0; i < dst->size(); ++i) (*dst)[i] += weights[k] * (*srcs[k])[i];
+                }
+            };
+        } else if (node["history"]) {
+            auto* src = _read(node["history"]["input"].as<std::string>(), produced);
+            auto* dst = _write(out_name, produced);
+            const auto length = node["history"]["length"].as<size_t>();
+            const auto fill = node["history"]["fill"] ? node["history"]["fill"].as<std::string>() : std::string("first");
+            if (length == 0) throw error("history length must be positive.");
+            if (fill != "first" && fill != "zeros") throw error("history fill must be first or zeros.");
+            // ring[head] is the oldest frame; the frame size is taken from the first step after a reset
+            auto ring = std::make_shared<std::vector<float>>();
+            auto head = std::make_shared<size_t>(0);
+            stage.reset = [ring, head] { ring->clear(); *head = 0; };
+            stage.run = [src, dst, length, fill, ring, head, error] {
+                const size_t frame = src->size();
+                if (ring->empty()) {
+                    ring->assign(length * frame, 0.0f);
+                    if (fill == "first") {
+                        for (size_t k = 0; k < length; ++k) std::copy(src->begin(), src->end(), ring->begin() + k * frame);
+                    }
+                    dst->resize(length * frame);
+                } else if (ring->size() != length * frame) {
+                    throw error("history input changed size.");
+                }
+                std::copy(src->begin(), src->end(), ring->begin() + *head * frame);
+                *head = (*head + 1) % length;
+                const auto split = ring->begin() + *head * frame;
+                std::copy(split, ring->end(), dst->begin());
+                std::copy(ring->begin(), split, dst->begin() + (ring->end() - split));
+            };
+        } else {
+            throw error("expected one of model, concat, gather, slice, sum, history.");
+        }
+    }
+
+    std::unordered_map<std::string, std::vector<float>> tensors_; // node-based: pointers stay valid
+    std::deque<Stage> stages_;
+    std::vector<std::string> input_names_;
+    std::vector<std::vector<float>*> inputs_;
+    std::vector<std::string> output_names_;
+    std::vector<std::vector<float>*> outputs_;
+    std::map<std::string, std::vector<float>> act_results_;
+    long step_ = 0;
+};
+
+// Policy of a `policy_dir`: the inference_graph of deploy.yaml if present, otherwise exported/policy.onnx.
+inline std::unique_ptr<Algorithms> make_policy_from_dir(
+    const std::filesystem::path& policy_dir, const YAML::Node& deploy_cfg, const PolicyOptions& opts)
+{
+    if (deploy_cfg["inference_graph"]) {
+        return std::make_unique<InferenceGraph>(deploy_cfg["inference_graph"], policy_dir, opts);
+    }
+    return make_policy(policy_dir / "exported" / "policy.onnx", opts);
+}
+
+};
@@ -0,0 +1,518 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "onnxruntime_cxx_api.h"
+#include "isaaclab/algorithms/autotune.h"
+#include "isaaclab/algorithms/profiler.h"
+#include "isaaclab/algorithms/session_config.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Process-wide ONNX Runtime state shared by every FSM state.
+ *
+ * Owns the single Ort::Env. With `global_thread_pools` enabled (default) the Env carries one intra-op and
+ * one inter-op pool, and every session created through create_session() runs on them instead of spawning
+ * its own pools, so idle states no longer keep threads competing for the control cores. A state can still
+ * give its sessions their own pools (SessionConfig, session_config.h).
+ *
+ * config.yaml:
+ *   inference:
+ *     global_thread_pools: true
+ *     intra_op_num_threads: 2       # 0: ORT default (one per physical core)
+ *     inter_op_num_threads: 1
+ *     allow_spinning: false
+ *     intra_op_thread_affinity: ""  # ORT affinity string, e.g. "3;4" (one entry per pool thread)
+ *     model_cache: true             # reuse ORT-format optimized models across boots
+ *     model_cache_dir: ""           # empty: <model dir>/ort_cache
+ *     share_sessions: true          # one session per (model, options) across states
+ *     autotune: false               # benchmark thread / spinning / opt-level candidates of CPU sessions
+ *     autotune_iterations: 200      #   and keep the fastest p99 (autotune.h)
+ *
+ * Cached models are named <stem>.<model hash>.<config hash>.ort, where the config hash covers the ORT version,
+ * the provider set and the optimization level. Entries of an older model file are removed on the next miss.
+ *
+ * With `share_sessions`, states that load the same model file with the same effective SessionConfig get the
+ * same Ort::Session (Run is thread-safe; I/O buffers stay with each caller). CPU sessions also share one
+ * PrepackedWeightsContainer, so kernels that prepack weights keep a single copy for identical initializers.
+ *
+ * Autotuning benchmarks only on threads that are not inside a BackgroundScope (the FSM background loader):
+ * there the control loop is already running, so the candidates would steal its CPU and be measured on a
+ * busy machine. Such sessions reuse a stored result or keep their config, and tune on the next eager boot.
+ *
+ * Sessions created with `profile_steps` run under ORT's profiler until profile_step() counted that many runs;
+ * the profile is then summarized off the control thread into <profile>.summary.txt (profiler.h).
+ */
+class InferenceRuntime
+{
+public:
+    struct Config
+    {
+        bool global_thread_pools = true;
+        int intra_op_num_threads = 0;
+        int inter_op_num_threads = 0;
+        bool allow_spinning = false;
+        std::string intra_op_thread_affinity;
+        bool model_cache = true;
+        std::string model_cache_dir;
+        bool share_sessions = true;
+        bool autotune = false;
+        int autotune_iterations = 200;
+    };
+
+    static InferenceRuntime& instance()
+    {
+        static InferenceRuntime runtime;
+        return runtime;
+    }
+
+    // Marks the current thread as loading alongside the running control loop for its lifetime.
+    class BackgroundScope
+    {
+    public:
+        BackgroundScope() { _background() = true; }
+        ~BackgroundScope() { _background() = false; }
+        BackgroundScope(const BackgroundScope&) = delete;
+        BackgroundScope& operator=(const BackgroundScope&) = delete;
+    };
+
+    // Must be called before the first session is created; later calls are ignored.
+    void configure(const YAML::Node& cfg)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (env_) {
+            spdlog::warn("InferenceRuntime: already initialized, ignoring configuration.");
+            return;
+        }
+        if (!cfg || cfg.IsNull()) return;
+
+        if (cfg["global_thread_pools"]) cfg_.global_thread_pools = cfg["global_thread_pools"].as<bool>();
+        if (cfg["intra_op_num_threads"]) cfg_.intra_op_num_threads = cfg["intra_op_num_threads"].as<int>();
+        if (cfg["inter_op_num_threads"]) cfg_.inter_op_num_threads = cfg["inter_op_num_threads"].as<int>();
+        if (cfg["allow_spinning"]) cfg_.allow_spinning = cfg["allow_spinning"].as<bool>();
+        if (cfg["intra_op_thread_affinity"] && !cfg["intra_op_thread_affinity"].IsNull()) {
+            cfg_.intra_op_thread_affinity = cfg["intra_op_thread_affinity"].as<std::string>();
+        }
+        if (cfg["model_cache"]) cfg_.model_cache = cfg["model_cache"].as<bool>();
+        if (cfg["model_cache_dir"] && !cfg["model_cache_dir"].IsNull()) {
+            cfg_.model_cache_dir = cfg["model_cache_dir"].as<std::string>();
+        }
+        if (cfg["share_sessions"]) cfg_.share_sessions = cfg["share_sessions"].as<bool>();
+        if (cfg["autotune"]) cfg_.autotune = cfg["autotune"].as<bool>();
+        if (cfg["autotune_iterations"]) cfg_.autotune_iterations = cfg["autotune_iterations"].as<int>();
+    }
+
+    const Config& config() const { return cfg_; }
+
+    Ort::Env& env()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return _env_locked();
+    }
+
+    // Apply the threading policy to a session's options: the shared pools, or the session's own pools when
+    // it sets any thread option (unset ones fall back to this config).
+    void apply(Ort::SessionOptions& options, const SessionConfig& session = {}) const
+    {
+        if (cfg_.global_thread_pools && !session.per_session_threads()) {
+            options.DisablePerSessionThreads();
+            return;
+        }
+        const auto threads = _session_threads(session);
+        if (threads.intra > 0) options.SetIntraOpNumThreads(threads.intra);
+        if (threads.inter > 0) options.SetInterOpNumThreads(threads.inter);
+        options.AddConfigEntry("session.intra_op.allow_spinning", threads.spinning ? "1" : "0");
+        options.AddConfigEntry("session.inter_op.allow_spinning", threads.spinning ? "1" : "0");
+    }
+
+    /**
+     * Create a session on the shared Env and register it under `owner` (e.g. "State_BFM").
+     * `session` selects the execution provider and tunes the session (see session_config.h); the provider
+     * that took effect ("TensorRT", "CUDA" or "CPU") is written to `selected_provider`. The provider and the
+     * optimization level are part of the model cache key. Compiled providers (TensorRT) keep their own
+     * engine cache and bypass this one. With autotune enabled, CPU sessions replace the threading and
+     * optimization level of `session` with the stored or freshly measured fastest setting.
+     * The returned session may be shared with other callers (share_sessions); `options` must then carry
+     * nothing beyond what `session` describes.
+     */
+    std::shared_ptr<Ort::Session> create_session(
+        const std::string& model_path, Ort::SessionOptions& options, const std::string& owner,
+        const SessionConfig& requested = {}, std::string* selected_provider = nullptr)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        const std::string providers = requested.append_providers(options, owner);
+        const SessionConfig session = _autotuned(model_path, owner, requested, providers);
+        apply(options, session);
+        options.SetExecutionMode(session.execution_mode);
+        options.SetGraphOptimizationLevel(session.opt_level);
+        const bool profiling = session.profile_steps > 0;
+        if (profiling) {
+            std::error_code ec;
+            std::filesystem::create_directories(session.profile_dir, ec);
+            options.EnableProfiling(_profile_prefix(session.profile_dir, owner).c_str());
+        }
+        if (selected_provider) *selected_provider = providers;
+
+        const std::string share_key = _share_key(model_path, providers, session);
+        if (cfg_.share_sessions && !profiling) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            auto it = shared_.find(share_key);
+            if (it != shared_.end()) {
+                if (auto shared = it->second.session.lock()) {
+                    sessions_.push_back({owner, model_path, true});
+                    spdlog::info("InferenceRuntime: [{}] {} shares the session of [{}] (providers={})", owner,
+                        std::filesystem::path(model_path).filename().string(), it->second.owner, providers);
+                    return shared;
+                }
+            }
+        }
+
+        OrtPrepackedWeightsContainer* prepacked = providers == "CPU" ? _prepacked_weights() : nullptr;
+        std::shared_ptr<Ort::Session> ort_session;
+        std::string cache_status = "disabled";
+        if (cfg_.model_cache && providers != "TensorRT") {
+            ort_session = _create_cached_session(model_path, options, owner, providers, session.opt_level, prepacked, cache_status);
+        }
+        if (!ort_session) {
+            ort_session = prepacked
+                ? std::make_shared<Ort::Session>(env(), model_path.c_str(), options, prepacked)
+                : std::make_shared<Ort::Session>(env(), model_path.c_str(), options);
+        }
+
+        std::string threads = "global";
+        if (!cfg_.global_thread_pools || session.per_session_threads()) {
+            const auto t = _session_threads(session);
+            threads = "session(intra=" + std::to_string(t.intra) + ", inter=" + std::to_string(t.inter)
+                + ", spinning=" + (t.spinning ? "on" : "off") + ")";
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        sessions_.push_back({owner, model_path, false});
+        if (cfg_.share_sessions && !profiling) shared_[share_key] = {owner, ort_session};
+        if (profiling) {
+            profiled_.push_back({owner, ort_session, session.profile_steps, 0});
+            profiling_ = true;
+            spdlog::info("InferenceRuntime: [{}] profiling the next {} runs into {}", owner, session.profile_steps, session.profile_dir);
+        }
+        spdlog::info("InferenceRuntime: [{}] {} loaded in {:.3f}s (providers={}, threads={}, mode={}, opt={}, model cache {})",
+            owner, std::filesystem::path(model_path).filename().string(),
+            std::chrono::duration<double>(clock::now() - t0).count(), providers, threads,
+            session.execution_mode == ORT_PARALLEL ? "parallel" : "sequential", SessionConfig::opt_level_name(session.opt_level),
+            cache_status);
+        return ort_session;
+    }
+
+    struct SessionRecord
+    {
+        std::string owner;
+        std::string model_path;
+        bool shared; // reused an existing session
+    };
+
+    std::vector<SessionRecord> sessions() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return sessions_;
+    }
+
+    // Directory holding derived artifacts (optimized/quantized models) for `model_path`.
+    std::filesystem::path cache_dir(const std::filesystem::path& model_path) const
+    {
+        return cfg_.model_cache_dir.empty() ? model_path.parent_path() / "ort_cache" : std::filesystem::path(cfg_.model_cache_dir);
+    }
+
+    // 16 hex digits identifying a model file's content.
+    static std::string content_hash(const std::string& bytes)
+    {
+        return _hex(_fnv1a(bytes.data(), bytes.size()), 16);
+    }
+
+    /**
+     * Count one Run of `session`, called by the policy loops after every inference. Free unless some session
+     * is being profiled; ends the profile of `session` once it reached its step budget (ORT writes the JSON
+     * on that call, parsing happens on a separate thread).
+     */
+    void profile_step(Ort::Session& session)
+    {
+        if (!profiling_.load(std::memory_order_relaxed)) return;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        // Sessions destroyed before their budget (an FP32 model replaced by INT8, a rejected candidate) end here.
+        profiled_.erase(std::remove_if(profiled_.begin(), profiled_.end(), [](const Profiled& p) { return p.session.expired(); }),
+            profiled_.end());
+        profiling_ = !profiled_.empty();
+        auto it = std::find_if(profiled_.begin(), profiled_.end(),
+            [&](const Profiled& p) { return p.session.lock().get() == &session; });
+        if (it == profiled_.end() || ++it->runs < it->steps) return;
+
+        Ort::AllocatorWithDefaultOptions allocator;
+        const std::string json_path = session.EndProfilingAllocated(allocator).get();
+        const std::string owner = it->owner;
+        profiled_.erase(it);
+        profiling_ = !profiled_.empty();
+
+        summarizers_.emplace_back([json_path, owner] {
+            try {
+                const auto summary = ProfileSummary::parse(json_path);
+                const auto summary_path = std::filesystem::path(json_path).replace_extension(".summary.txt");
+                std::ofstream(summary_path) << summary.report();
+                spdlog::info("InferenceRuntime: [{}] profile of {} runs written to {} (hot ops: {})",
+                    owner, summary.runs(), summary_path.string(), summary.hot_ops());
+            } catch (const std::exception& e) {
+                spdlog::error("InferenceRuntime: [{}] cannot summarize profile {}: {}", owner, json_path, e.what());
+            }
+        });
+    }
+
+private:
+    InferenceRuntime() = default;
+
+    ~InferenceRuntime()
+    {
+        for (auto& t : summarizers_) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    static std::string _profile_prefix(const std::string& dir, const std::string& owner)
+    {
+        std::string name = owner;
+        std::replace(name.begin(), name.end(), '/', '_');
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::ostringstream ss;
+        ss << "ort_profile_" << name << "_" << std::put_time(std::localtime(&now), "%Y-%m-%d_%H-%M-%S");
+        return (std::filesystem::path(dir) / ss.str()).string();
+    }
+
+    struct Threads { int intra; int inter; bool spinning; };
+
+    Threads _session_threads(const SessionConfig& session) const
+    {
+        return {
+            session.intra_op_num_threads > 0 ? session.intra_op_num_threads : cfg_.intra_op_num_threads,
+            session.inter_op_num_threads > 0 ? session.inter_op_num_threads : cfg_.inter_op_num_threads,
+            session.allow_spinning >= 0 ? session.allow_spinning == 1 : cfg_.allow_spinning,
+        };
+    }
+
+    SessionConfig _autotuned(
+        const std::string& model_path, const std::string& owner, const SessionConfig& session, const std::string& providers)
+    {
+        if (session.autotune < 0 ? !cfg_.autotune : session.autotune == 0) return session;
+        if (providers != "CPU") {
+            spdlog::info("InferenceRuntime: [{}] autotune skipped (providers={})", owner, providers);
+            return session;
+        }
+        try {
+            std::ifstream file(model_path, std::ios::binary);
+            if (!file) throw std::runtime_error("cannot open model");
+            const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            SessionAutotuner tuner(model_path, content_hash(bytes), owner, cfg_.autotune_iterations);
+            if (_background()) {
+                if (auto stored = tuner.lookup(session)) {
+                    spdlog::info("InferenceRuntime: [{}] autotune reused {} (p50 {:.1f}us, p99 {:.1f}us)", owner,
+                        SessionAutotuner::describe(stored->config), stored->p50_us, stored->p99_us);
+                    return stored->config;
+                }
+                spdlog::warn("InferenceRuntime: [{}] autotune deferred: not benchmarking on the background loader "
+                    "while the control loop runs; boot once with background_loading: false to tune", owner);
+                return session;
+            }
+            const auto result = tuner.tune(session, [&](const SessionConfig& candidate) {
+                Ort::SessionOptions options;
+                candidate.append_providers(options, owner);
+                apply(options, candidate);
+                options.SetExecutionMode(candidate.execution_mode);
+                options.SetGraphOptimizationLevel(candidate.opt_level);
+                return std::make_unique<Ort::Session>(env(), model_path.c_str(), options);
+            });
+            spdlog::info("InferenceRuntime: [{}] autotune {} {} (p50 {:.1f}us, p99 {:.1f}us)", owner,
+                result.reused ? "reused" : "selected", SessionAutotuner::describe(result.config), result.p50_us, result.p99_us);
+            return result.config;
+        } catch (const std::exception& e) {
+            spdlog::warn("InferenceRuntime: [{}] autotune of {} failed: {}", owner, model_path, e.what());
+            return session;
+        }
+    }
+
+    static bool& _background()
+    {
+        thread_local bool background = false;
+        return background;
+    }
+
+    static uint64_t _fnv1a(const char* data, std::size_t size, uint64_t hash = 14695981039346656037ull)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static std::string _hex(uint64_t value, int width)
+    {
+        std::ostringstream ss;
+        ss << std::hex << std::setw(width) << std::setfill('0') << value;
+        return ss.str().substr(0, width);
+    }
+
+    // Everything that makes two sessions of one model file behave differently.
+    std::string _share_key(const std::string& model_path, const std::string& providers, const SessionConfig& session) const
+    {
+        std::error_code ec;
+        auto path = std::filesystem::weakly_canonical(model_path, ec);
+        const auto t = _session_threads(session);
+        const bool own_threads = !cfg_.global_thread_pools || session.per_session_threads();
+        return (ec ? model_path : path.string()) + "|" + providers + "|" + std::to_string(session.device_id)
+            + "|" + std::to_string(session.trt_fp16) + "|" + session.trt_cache_dir
+            + "|" + (own_threads ? std::to_string(t.intra) + "," + std::to_string(t.inter) + "," + std::to_string(t.spinning) : "global")
+            + "|" + std::to_string(static_cast<int>(session.execution_mode)) + "|" + std::to_string(static_cast<int>(session.opt_level));
+    }
+
+    OrtPrepackedWeightsContainer* _prepacked_weights()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!prepacked_) prepacked_ = std::make_unique<Ort::PrepackedWeightsContainer>();
+        return *prepacked_;
+    }
+
+    std::shared_ptr<Ort::Session> _create_cached_session(
+        const std::string& model_path, Ort::SessionOptions& options, const std::string& owner,
+        const std::string& providers, GraphOptimizationLevel opt_level, OrtPrepackedWeightsContainer* prepacked,
+        std::string& cache_status)
+    {
+        namespace fs = std::filesystem;
+        const fs::path model(model_path);
+
+        std::ifstream file(model, std::ios::binary);
+        if (!file) return nullptr;
+        const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        // Level `all` bakes in layout transforms for this CPU, so that cache is only valid on the same host.
+        std::string config_key = std::string(OrtGetApiBase()->GetVersionString())
+            + "|" + providers + "|" + std::to_string(static_cast<int>(opt_level));
+        if (opt_level == ORT_ENABLE_ALL) config_key += "|" + SessionAutotuner::host_hash();
+        const std::string model_hash = content_hash(bytes);
+        const std::string config_hash = _hex(_fnv1a(config_key.data(), config_key.size()), 8);
+
+        const fs::path cache_dir = this->cache_dir(model);
+        const std::string prefix = model.stem().string() + ".";
+        const fs::path cache_path = cache_dir / (prefix + model_hash + "." + config_hash + ".ort");
+
+        if (fs::exists(cache_path)) {
+            try {
+                Ort::SessionOptions cached = options.Clone();
+                cached.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+                cached.AddConfigEntry("session.load_model_format", "ORT");
+                auto session = prepacked
+                    ? std::make_shared<Ort::Session>(env(), cache_path.c_str(), cached, prepacked)
+                    : std::make_shared<Ort::Session>(env(), cache_path.c_str(), cached);
+                cache_status = "hit";
+                return session;
+            } catch (const std::exception& e) {
+                spdlog::warn("InferenceRuntime: [{}] dropping unreadable cache {}: {}", owner, cache_path.string(), e.what());
+                std::error_code ec;
+                fs::remove(cache_path, ec);
+            }
+        }
+
+        std::error_code ec;
+        fs::create_directories(cache_dir, ec);
+        // Drop entries written for a previous version of this model file
+        for (const auto& entry : fs::directory_iterator(cache_dir, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind(prefix, 0) == 0 && entry.path().extension() == ".ort"
+                && name.compare(prefix.size(), model_hash.size(), model_hash) != 0) {
+                fs::remove(entry.path(), ec);
+            }
+        }
+
+        const fs::path tmp_path = cache_path.string() + ".tmp";
+        try {
+            Ort::SessionOptions saving = options.Clone();
+            saving.SetOptimizedModelFilePath(tmp_path.c_str());
+            saving.AddConfigEntry("session.save_model_format", "ORT");
+            auto session = prepacked
+                ? std::make_shared<Ort::Session>(env(), model_path.c_str(), saving, prepacked)
+                : std::make_shared<Ort::Session>(env(), model_path.c_str(), saving);
+            fs::rename(tmp_path, cache_path, ec);
+            cache_status = ec ? "miss (not saved)" : "miss";
+            return session;
+        } catch (const std::exception& e) {
+            spdlog::warn("InferenceRuntime: [{}] cannot save optimized model for {}: {}", owner, model_path, e.what());
+            fs::remove(tmp_path, ec);
+            cache_status = "unsupported";
+            return nullptr;
+        }
+    }
+
+    Ort::Env& _env_locked()
+    {
+        if (env_) return *env_;
+
+        if (cfg_.global_thread_pools) {
+            Ort::ThreadingOptions tp_options;
+            tp_options.SetGlobalIntraOpNumThreads(cfg_.intra_op_num_threads);
+            tp_options.SetGlobalInterOpNumThreads(cfg_.inter_op_num_threads);
+            tp_options.SetGlobalSpinControl(cfg_.allow_spinning ? 1 : 0);
+            if (!cfg_.intra_op_thread_affinity.empty()) {
+                Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(
+                    tp_options, cfg_.intra_op_thread_affinity.c_str()));
+            }
+            env_ = std::make_unique<Ort::Env>(tp_options, ORT_LOGGING_LEVEL_WARNING, "unitree_deploy");
+            spdlog::info("InferenceRuntime: global thread pools intra_op={} inter_op={} spinning={} affinity='{}'",
+                cfg_.intra_op_num_threads, cfg_.inter_op_num_threads, cfg_.allow_spinning, cfg_.intra_op_thread_affinity);
+        } else {
+            env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "unitree_deploy");
+            spdlog::info("InferenceRuntime: per-session thread pools");
+        }
+        return *env_;
+    }
+
+    struct SharedSession
+    {
+        std::string owner;
+        std::weak_ptr<Ort::Session> session;
+    };
+
+    Config cfg_;
+    std::unique_ptr<Ort::Env> env_;
+    std::unique_ptr<Ort::PrepackedWeightsContainer> prepacked_; // must outlive the sessions created with it
+    std::vector<SessionRecord> sessions_;
+    std::map<std::string, SharedSession> shared_;
+
+    struct Profiled
+    {
+        std::string owner;
+        std::weak_ptr<Ort::Session> session;
+        int steps;
+        int runs;
+    };
+    std::vector<Profiled> profiled_;
+    std::atomic<bool> profiling_{false};
+    std::vector<std::thread> summarizers_;
+    mutable std::mutex mtx_;
+};
+
+};
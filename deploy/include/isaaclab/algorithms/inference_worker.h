@@ -0,0 +1,103 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace isaaclab
+{
+
+/**
+ * Dedicated thread that runs one job at a time for a policy loop.
+ *
+ * The loop submit()s a model stage, does work that does not depend on its result, then wait()s. Exceptions
+ * thrown by the job are rethrown from wait(). job_ms() is the duration of the last job on the worker.
+ */
+class InferenceWorker
+{
+public:
+    InferenceWorker()
+    : thread_([this] { _loop(); })
+    {
+    }
+
+    ~InferenceWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    InferenceWorker(const InferenceWorker&) = delete;
+    InferenceWorker& operator=(const InferenceWorker&) = delete;
+
+    void submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (pending_) throw std::runtime_error("InferenceWorker: submit() while a job is pending");
+            job_ = std::move(job);
+            pending_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return !pending_; });
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    double job_ms() const { return job_ms_; }
+
+private:
+    void _loop()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        while (true)
+        {
+            cv_.wait(lock, [this] { return pending_ || stop_; });
+            if (stop_) return;
+            auto job = std::move(job_);
+            lock.unlock();
+
+            const auto t0 = std::chrono::steady_clock::now();
+            std::exception_ptr error;
+            try {
+                job();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+            lock.lock();
+            job_ms_ = ms;
+            error_ = error;
+            pending_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::function<void()> job_;
+    std::exception_ptr error_;
+    double job_ms_ = 0.0;
+    bool pending_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+};
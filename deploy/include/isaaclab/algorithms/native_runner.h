@@ -0,0 +1,1040 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "isaaclab/algorithms/algorithms.h"
+#include "isaaclab/algorithms/onnx_model.h"
+#include <eigen3/Eigen/Dense>
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+namespace isaaclab
+{
+
+/**
+ * In-process policy backend for small exported networks (MLP / MoE heads).
+ *
+ * The ONNX graph is compiled once at load time for the static input shapes: every intermediate tensor gets a
+ * preallocated buffer, everything that only depends on constants or shapes (Shape/Gather/Concat index math,
+ * NonZero masks, ...) is folded, and Gemm/MatMul/Conv weights are packed into Eigen matrices. A step then runs
+ * a flat list of kernels over those buffers without touching the heap.
+ *
+ * Supported ops: Gemm, MatMul, Conv (pointwise), Add/Sub/Mul/Div/Pow, Relu/Elu/LeakyRelu/Tanh/Sigmoid/Softplus/
+ * Exp/Log/Sqrt/Abs/Neg/Clip/Cast/Identity, Softmax/LogSoftmax, Reduce{Sum,Mean,Max,Min,L2}, Slice, Gather,
+ * Concat, Transpose, Expand, Reshape/Flatten/Squeeze/Unsqueeze, Shape, Constant, ConstantOfShape, NonZero, Range.
+ * Anything else throws at load time.
+ *
+ * Mixture-of-experts heads of the form ReduceSum(Softmax gate * grouped Conv experts) can run sparsely
+ * (MoeSparsity): before the expert Conv, each step keeps the top-k experts and/or those whose gate weight
+ * reaches a threshold, evaluates only their groups and mixes them with the renormalized gate weights. The
+ * gate output itself (e.g. "weights") stays dense.
+ */
+struct MoeSparsity
+{
+    int top_k = 0;          // keep at most this many experts, 0: no limit
+    float threshold = 0.0f; // drop experts whose gate weight is below this, the top-1 is always kept
+    float tol = 0.05f;      // max error against dense execution at load time (policy_factory.h)
+
+    bool enabled() const { return top_k > 0 || threshold > 0.0f; }
+};
+
+class NativeRunner : public Algorithms
+{
+public:
+    explicit NativeRunner(const std::string& model_path, MoeSparsity moe = {})
+    : moe_(moe)
+    {
+        auto model = onnx::load(model_path);
+        opset_ = model.opset;
+        if (moe_.enabled()) _find_moe_blocks(model);
+
+        for (auto& [name, init] : model.initializers) {
+            auto& t = _new_value(name);
+            t.shape = init.dims;
+            t.data = std::move(init.data);
+            t.is_int = init.is_int;
+            t.is_const = true;
+            if (!t.is_int) num_params_ += t.data.size();
+        }
+        for (const auto& input : model.inputs) {
+            auto& t = _new_value(input.name);
+            t.shape = input.shape;
+            for (auto& dim : t.shape) {
+                if (dim < 0) dim = 1; // symbolic batch dimension
+            }
+            t.data.assign(_numel(t.shape), 0.0f);
+            input_names_.push_back(input.name);
+            inputs_.push_back(&t);
+        }
+
+        for (const auto& node : model.nodes) {
+            _compile(node);
+        }
+
+        for (const auto& output : model.outputs) {
+            auto it = values_by_name_.find(output.name);
+            if (it == values_by_name_.end()) {
+                throw std::runtime_error("NativeRunner: graph output '" + output.name + "' is never produced.");
+            }
+            output_names_.push_back(output.name);
+            outputs_.push_back(it->second);
+        }
+
+        action_index_ = 0;
+        for (size_t i = 0; i < output_names_.size(); ++i) {
+            if (output_names_[i] == "actions") { action_index_ = i; break; }
+        }
+        if (!outputs_.empty()) action.resize(outputs_[action_index_]->data.size());
+
+        spdlog::info("NativeRunner: {} nodes compiled to {} kernels ({} folded), {} parameters",
+            model.nodes.size(), program_.size(), model.nodes.size() - program_.size(), num_params_);
+        if (moe_.enabled() && moe_blocks() == 0) {
+            spdlog::warn("NativeRunner: moe_sparse is set but {} has no gated MoE block, running dense.", model_path);
+        }
+    }
+
+    ~NativeRunner() override
+    {
+        for (const auto& block : moe_blocks_) {
+            if (block.steps == 0 || !moe_sparse_) continue;
+            spdlog::info("NativeRunner: MoE '{}' ran {:.2f} of {} experts on average over {} steps",
+                block.experts, static_cast<double>(block.active_total) / block.steps, block.num_experts, block.steps);
+        }
+    }
+
+    std::vector<float> act(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        auto results = forward(obs);
+        if (results.count("actions")) {
+            return results["actions"];
+        } else if (!results.empty()) {
+            return results.begin()->second;
+        }
+        return {};
+    }
+
+    std::map<std::string, std::vector<float>> forward(const std::unordered_map<std::string, std::vector<float>>& obs) override
+    {
+        std::map<std::string, std::vector<float>> results;
+        _run(obs);
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            results[output_names_[i]] = outputs_[i]->data;
+        }
+        _publish_action();
+        return results;
+    }
+
+    void forward_into(
+        const std::unordered_map<std::string, std::vector<float>>& obs,
+        std::map<std::string, std::vector<float>>& results) override
+    {
+        _run(obs);
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            if (i != action_index_ && !is_output_requested(output_names_[i])) continue;
+            results[output_names_[i]].assign(outputs_[i]->data.begin(), outputs_[i]->data.end());
+        }
+        _publish_action();
+    }
+
+    const std::vector<std::string>& input_names() const { return input_names_; }
+    const std::vector<std::string>& output_names() const { return output_names_; }
+    std::vector<int64_t> input_shape(size_t i) const { return inputs_[i]->shape; }
+
+    // Number of MoE blocks that run sparsely when enabled.
+    size_t moe_blocks() const
+    {
+        return std::count_if(moe_blocks_.begin(), moe_blocks_.end(), [](const MoeBlock& b) { return b.num_experts > 0; });
+    }
+
+    // Switch between sparse and dense expert execution (dense: all experts, original gate weights).
+    void set_moe_sparse(bool sparse) { moe_sparse_ = sparse; }
+
+    // Average experts evaluated per step and block since the last call.
+    double moe_active_experts()
+    {
+        long steps = 0, active = 0;
+        for (const auto& block : moe_blocks_) {
+            steps += block.steps; active += block.active_total;
+        }
+        reset_moe_counters();
+        return steps ? static_cast<double>(active) / steps : 0.0;
+    }
+
+    // Forget the experts counted so far, e.g. after benchmark runs that should not show in the next report.
+    void reset_moe_counters()
+    {
+        for (auto& block : moe_blocks_) block.steps = block.active_total = 0;
+    }
+
+private:
+    using RowMatrix = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    struct Tensor
+    {
+        std::vector<int64_t> shape;
+        std::vector<float> data;
+        bool is_int = false;
+        bool is_const = false;
+    };
+
+    // A gated expert layer; `mix` holds the per-step weights of the selected experts and 0 for skipped ones.
+    struct MoeBlock
+    {
+        std::string gate;    // Softmax output
+        std::string experts; // grouped Conv output
+        std::string product; // gate * experts, summed over the expert axis by the next ReduceSum
+        size_t gate_input = 0; // operand of `product` that carries the gate
+        int64_t num_experts = 0;
+        const float* weights = nullptr;
+        std::vector<float> mix;
+        std::vector<int> order;
+        long steps = 0;
+        long active_total = 0;
+    };
+
+    void _run(const std::unordered_map<std::string, std::vector<float>>& obs)
+    {
+        for (size_t i = 0; i < inputs_.size(); ++i)
+        {
+            auto it = obs.find(input_names_[i]);
+            if (it == obs.end()) {
+                throw std::runtime_error("Input name '" + input_names_[i] + "' not found in observations.");
+            }
+            if (it->second.size() != inputs_[i]->data.size()) {
+                throw std::runtime_error("Input '" + input_names_[i] + "' expects " + std::to_string(inputs_[i]->data.size())
+                    + " values, got " + std::to_string(it->second.size()) + ".");
+            }
+            std::copy(it->second.begin(), it->second.end(), inputs_[i]->data.begin());
+        }
+        for (auto& kernel : program_) kernel();
+    }
+
+    void _publish_action()
+    {
+        if (outputs_.empty()) return;
+        std::lock_guard<std::mutex> lock(act_mtx_);
+        action.assign(outputs_[action_index_]->data.begin(), outputs_[action_index_]->data.end());
+    }
+
+    // ---- shape helpers ----
+
+    static size_t _numel(const std::vector<int64_t>& shape)
+    {
+        size_t n = 1;
+        for (auto d : shape) n *= static_cast<size_t>(d);
+        return n;
+    }
+
+    static std::vector<int64_t> _strides(const std::vector<int64_t>& shape)
+    {
+        std::vector<int64_t> s(shape.size(), 1);
+        for (int i = static_cast<int>(shape.size()) - 2; i >= 0; --i) s[i] = s[i + 1] * shape[i + 1];
+        return s;
+    }
+
+    static int64_t _axis(int64_t axis, size_t rank)
+    {
+        if (axis < 0) axis += static_cast<int64_t>(rank);
+        if (axis < 0 || axis >= static_cast<int64_t>(std::max<size_t>(rank, 1))) {
+            throw std::runtime_error("NativeRunner: axis out of range");
+        }
+        return axis;
+    }
+
+    static std::vector<int64_t> _broadcast_shape(const std::vector<int64_t>& a, const std::vector<int64_t>& b)
+    {
+        const size_t rank = std::max(a.size(), b.size());
+        std::vector<int64_t> out(rank);
+        for (size_t i = 0; i < rank; ++i) {
+            const int64_t da = i < rank - a.size() ? 1 : a[i - (rank - a.size())];
+            const int64_t db = i < rank - b.size() ? 1 : b[i - (rank - b.size())];
+            if (da != db && da != 1 && db != 1) throw std::runtime_error("NativeRunner: shapes are not broadcastable");
+            out[i] = std::max(da, db);
+        }
+        return out;
+    }
+
+    // For every element of `out_shape`, the flat index of the element of `in_shape` it reads under broadcasting.
+    static std::vector<int32_t> _broadcast_index(const std::vector<int64_t>& in_shape, const std::vector<int64_t>& out_shape)
+    {
+        const size_t rank = out_shape.size();
+        std::vector<int64_t> in_strides(rank, 0);
+        const auto s = _strides(in_shape);
+        for (size_t i = 0; i < in_shape.size(); ++i) {
+            const size_t o = rank - in_shape.size() + i;
+            in_strides[o] = in_shape[i] == 1 ? 0 : s[i];
+        }
+        return _index_map(out_shape, [&](const std::vector<int64_t>& idx) {
+            int64_t src = 0;
+            for (size_t i = 0; i < rank; ++i) src += idx[i] * in_strides[i];
+            return src;
+        });
+    }
+
+    template <typename Fn>
+    static std::vector<int32_t> _index_map(const std::vector<int64_t>& out_shape, Fn src_of)
+    {
+        const size_t n = _numel(out_shape);
+        std::vector<int32_t> map(n);
+        std::vector<int64_t> idx(out_shape.size(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            map[i] = static_cast<int32_t>(src_of(idx));
+            for (int d = static_cast<int>(idx.size()) - 1; d >= 0; --d) {
+                if (++idx[d] < out_shape[d]) break;
+                idx[d] = 0;
+            }
+        }
+        return map;
+    }
+
+    static std::vector<int64_t> _as_ints(const Tensor& t)
+    {
+        // int64 tensors are held as float; keep INT64_MIN/MAX sentinels (open Slice ends) from overflowing
+        constexpr float limit = 9.2e18f;
+        std::vector<int64_t> v(t.data.size());
+        for (size_t i = 0; i < v.size(); ++i) {
+            const float x = t.data[i];
+            v[i] = x >= limit ? std::numeric_limits<int64_t>::max()
+                : x <= -limit ? std::numeric_limits<int64_t>::min() : static_cast<int64_t>(x);
+        }
+        return v;
+    }
+
+    // ---- graph compilation ----
+
+    Tensor& _new_value(const std::string& name)
+    {
+        values_.emplace_back();
+        values_by_name_[name] = &values_.back();
+        return values_.back();
+    }
+
+    const Tensor& _const_input(const std::vector<Tensor*>& in, size_t i, const onnx::Node& node)
+    {
+        if (i >= in.size() || !in[i] || !in[i]->is_const) {
+            throw std::runtime_error("NativeRunner: " + node.op_type + " '" + node.name + "' needs constant input #" + std::to_string(i));
+        }
+        return *in[i];
+    }
+
+    // Axes come from an attribute up to a given opset and from an optional input afterwards.
+    std::vector<int64_t> _axes(const onnx::Node& node, const std::vector<Tensor*>& in, size_t input_index)
+    {
+        if (node.has("axes")) return node.attr_ints("axes");
+        if (in.size() > input_index && in[input_index]) return _as_ints(_const_input(in, input_index, node));
+        return {};
+    }
+
+    // ReduceSum(Mul(Softmax gate, grouped Conv experts)), looking through reshapes on both Mul operands.
+    void _find_moe_blocks(const onnx::Model& model)
+    {
+        std::unordered_map<std::string, const onnx::Node*> producer;
+        for (const auto& node : model.nodes) for (const auto& o : node.outputs) producer[o] = &node;
+        auto source = [&](std::string name) -> const onnx::Node* {
+            for (;;) {
+                auto it = producer.find(name);
+                if (it == producer.end()) return nullptr;
+                const auto& op = it->second->op_type;
+                if (op != "Reshape" && op != "Squeeze" && op != "Unsqueeze" && op != "Flatten" && op != "Identity") return it->second;
+                name = it->second->inputs.at(0);
+            }
+        };
+
+        for (const auto& node : model.nodes) {
+            if (node.op_type != "ReduceSum") continue;
+            auto it = producer.find(node.inputs.at(0));
+            if (it == producer.end() || it->second->op_type != "Mul") continue;
+            const auto& mul = *it->second;
+            for (size_t gate_input : {0, 1}) {
+                const auto* gate = source(mul.inputs.at(gate_input));
+                const auto* experts = source(mul.inputs.at(1 - gate_input));
+                if (!gate || !experts || gate->op_type != "Softmax" || experts->op_type != "Conv") continue;
+                if (experts->attr_i("group", 1) < 2) continue;
+                MoeBlock block;
+                block.gate = gate->outputs.at(0);
+                block.experts = experts->outputs.at(0);
+                block.product = mul.outputs.at(0);
+                block.gate_input = gate_input;
+                moe_blocks_.push_back(std::move(block));
+                break;
+            }
+        }
+    }
+
+    // Block whose `field` names tensor `name`; blocks that failed validation have no experts.
+    MoeBlock* _moe_block(const std::string& name, std::string MoeBlock::*field)
+    {
+        for (auto& block : moe_blocks_) {
+            if (block.*field == name && (field == &MoeBlock::experts || block.num_experts > 0)) return &block;
+        }
+        return nullptr;
+    }
+
+    // Pick this step's experts from the gate and renormalize their weights; dense mode keeps the gate as is.
+    void _moe_select(MoeBlock& b)
+    {
+        const float* w = b.weights;
+        if (!moe_sparse_) {
+            std::copy(w, w + b.num_experts, b.mix.begin());
+            return;
+        }
+        const int64_t keep = moe_.top_k > 0 ? std::min<int64_t>(moe_.top_k, b.num_experts) : b.num_experts;
+        std::iota(b.order.begin(), b.order.end(), 0);
+        std::partial_sort(b.order.begin(), b.order.begin() + keep, b.order.end(), [w](int x, int y) { return w[x] > w[y]; });
+        std::fill(b.mix.begin(), b.mix.end(), 0.0f);
+        float sum = 0.0f;
+        int64_t active = 0;
+        for (int64_t i = 0; i < keep; ++i) {
+            const int e = b.order[i];
+            if (i > 0 && w[e] < moe_.threshold) break;
+            b.mix[e] = w[e];
+            sum += w[e];
+            ++active;
+        }
+        if (sum > 0.0f) for (auto& m : b.mix) m /= sum;
+        b.steps += 1;
+        b.active_total += active;
+    }
+
+    void _compile(const onnx::Node& node)
+    {
+        std::vector<Tensor*> in;
+        for (const auto& name : node.inputs) {
+            if (name.empty()) { in.push_back(nullptr); continue; }
+            auto it = values_by_name_.find(name);
+            if (it == values_by_name_.end()) {
+                throw std::runtime_error("NativeRunner: unknown tensor '" + name + "' used by " + node.op_type);
+            }
+            in.push_back(it->second);
+        }
+        const std::string& out_name = node.outputs.at(0);
+        Tensor& out = _new_value(out_name);
+
+        const std::string& op = node.op_type;
+        std::function<void()> kernel;
+        bool always_const = false;
+
+        if (op == "Constant") {
+            always_const = true;
+            if (node.has("value")) {
+                const auto& t = node.attributes.at("value").t;
+                out.shape = t.dims; out.data = t.data; out.is_int = t.is_int;
+            } else if (node.has("value_float")) {
+                out.data = {node.attr_f("value_float", 0.0f)};
+            } else if (node.has("value_floats")) {
+                out.data = node.attributes.at("value_floats").floats; out.shape = {static_cast<int64_t>(out.data.size())};
+            } else if (node.has("value_int")) {
+                out.data = {static_cast<float>(node.attr_i("value_int", 0))}; out.is_int = true;
+            } else if (node.has("value_ints")) {
+                for (auto v : node.attr_ints("value_ints")) out.data.push_back(static_cast<float>(v));
+                out.shape = {static_cast<int64_t>(out.data.size())}; out.is_int = true;
+            } else {
+                throw std::runtime_error("NativeRunner: unsupported Constant attribute in '" + node.name + "'");
+            }
+        } else if (op == "Shape") {
+            always_const = true;
+            const auto& shape = in[0]->shape;
+            int64_t start = node.attr_i("start", 0), end = node.attr_i("end", static_cast<int64_t>(shape.size()));
+            if (start < 0) start += shape.size();
+            if (end < 0) end += shape.size();
+            end = std::min<int64_t>(end, shape.size());
+            for (int64_t i = start; i < end; ++i) out.data.push_back(static_cast<float>(shape[i]));
+            out.shape = {static_cast<int64_t>(out.data.size())};
+            out.is_int = true;
+        } else if (op == "ConstantOfShape") {
+            always_const = true;
+            out.shape = _as_ints(_const_input(in, 0, node));
+            float value = 0.0f;
+            if (node.has("value")) {
+                value = node.attributes.at("value").t.data.at(0);
+                out.is_int = node.attributes.at("value").t.is_int;
+            }
+            out.data.assign(_numel(out.shape), value);
+        } else if (op == "NonZero") {
+            always_const = true;
+            const auto& x = _const_input(in, 0, node);
+            const auto strides = _strides(x.shape);
+            std::vector<int64_t> hits;
+            for (size_t i = 0; i < x.data.size(); ++i) if (x.data[i] != 0.0f) hits.push_back(i);
+            const int64_t rank = std::max<int64_t>(x.shape.size(), 1);
+            out.shape = {rank, static_cast<int64_t>(hits.size())};
+            out.data.resize(rank * hits.size());
+            for (size_t j = 0; j < hits.size(); ++j) {
+                int64_t rem = hits[j];
+                for (int64_t d = 0; d < static_cast<int64_t>(x.shape.size()); ++d) {
+                    out.data[d * hits.size() + j] = static_cast<float>(rem / strides[d]);
+                    rem %= strides[d];
+                }
+            }
+            out.is_int = true;
+        } else if (op == "Range") {
+            always_const = true;
+            const float start = _const_input(in, 0, node).data.at(0);
+            const float limit = _const_input(in, 1, node).data.at(0);
+            const float delta = _const_input(in, 2, node).data.at(0);
+            const int64_t n = std::max<int64_t>(static_cast<int64_t>(std::ceil((limit - start) / delta)), 0);
+            for (int64_t i = 0; i < n; ++i) out.data.push_back(start + i * delta);
+            out.shape = {n};
+            out.is_int = in[0]->is_int;
+        } else if (op == "Gemm") {
+            kernel = _compile_gemm(node, in, out);
+        } else if (op == "MatMul") {
+            kernel = _compile_matmul(node, in, out);
+        } else if (op == "Conv") {
+            kernel = _compile_conv(node, in, out, _moe_block(out_name, &MoeBlock::experts));
+        } else if (op == "Mul" && _moe_block(out_name, &MoeBlock::product)) {
+            kernel = _compile_moe_mix(in, out, *_moe_block(out_name, &MoeBlock::product));
+        } else if (op == "Add") {
+            kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return a + b; });
+        } else if (op == "Sub") {
+            kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return a - b; });
+        } else if (op == "Mul") {
+            kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return a * b; });
+        } else if (op == "Div") {
+            if (in[0]->is_int && in[1]->is_int) {
+                kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return std::trunc(a / b); });
+            } else {
+                kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return a / b; });
+            }
+        } else if (op == "Pow") {
+            kernel = _binary(*in[0], *in[1], out, [](float a, float b) { return std::pow(a, b); });
+        } else if (op == "Relu") {
+            kernel = _unary(*in[0], out, [](float x) { return x > 0.0f ? x : 0.0f; });
+        } else if (op == "Elu") {
+            const float alpha = node.attr_f("alpha", 1.0f);
+            kernel = _unary(*in[0], out, [alpha](float x) { return x > 0.0f ? x : alpha * (std::exp(x) - 1.0f); });
+        } else if (op == "LeakyRelu") {
+            const float alpha = node.attr_f("alpha", 0.01f);
+            kernel = _unary(*in[0], out, [alpha](float x) { return x > 0.0f ? x : alpha * x; });
+        } else if (op == "Tanh") {
+            kernel = _unary(*in[0], out, [](float x) { return std::tanh(x); });
+        } else if (op == "Sigmoid") {
+            kernel = _unary(*in[0], out, [](float x) { return 1.0f / (1.0f + std::exp(-x)); });
+        } else if (op == "Softplus") {
+            kernel = _unary(*in[0], out, [](float x) { return x > 20.0f ? x : std::log1p(std::exp(x)); });
+        } else if (op == "Exp") {
+            kernel = _unary(*in[0], out, [](float x) { return std::exp(x); });
+        } else if (op == "Log") {
+            kernel = _unary(*in[0], out, [](float x) { return std::log(x); });
+        } else if (op == "Sqrt") {
+            kernel = _unary(*in[0], out, [](float x) { return std::sqrt(x); });
+        } else if (op == "Abs") {
+            kernel = _unary(*in[0], out, [](float x) { return std::abs(x); });
+        } else if (op == "Neg") {
+            kernel = _unary(*in[0], out, [](float x) { return -x; });
+        } else if (op == "Clip") {
+            float lo = node.attr_f("min", -std::numeric_limits<float>::infinity());
+            float hi = node.attr_f("max", std::numeric_limits<float>::infinity());
+            if (in.size() > 1 && in[1]) lo = _const_input(in, 1, node).data.at(0);
+            if (in.size() > 2 && in[2]) hi = _const_input(in, 2, node).data.at(0);
+            kernel = _unary(*in[0], out, [lo, hi](float x) { return std::min(std::max(x, lo), hi); });
+        } else if (op == "Cast") {
+            const int64_t to = node.attr_i("to", 1);
+            if (to == 1 || to == 10 || to == 11) {
+                kernel = _unary(*in[0], out, [](float x) { return x; });
+                out.is_int = false;
+            } else if (to == 9) {
+                kernel = _unary(*in[0], out, [](float x) { return x != 0.0f ? 1.0f : 0.0f; });
+                out.is_int = true;
+            } else {
+                kernel = _unary(*in[0], out, [](float x) { return std::trunc(x); });
+                out.is_int = true;
+            }
+        } else if (op == "Identity" || op == "Dropout") {
+            kernel = _unary(*in[0], out, [](float x) { return x; });
+        } else if (op == "Softmax" || op == "LogSoftmax") {
+            kernel = _compile_softmax(node, *in[0], out, op == "LogSoftmax");
+        } else if (op == "ReduceSum" || op == "ReduceMean" || op == "ReduceMax" || op == "ReduceMin" || op == "ReduceL2") {
+            kernel = _compile_reduce(node, in, out);
+        } else if (op == "Reshape" || op == "Flatten" || op == "Squeeze" || op == "Unsqueeze") {
+            out.shape = _reshape_target(node, in);
+            out.is_int = in[0]->is_int;
+            if (_numel(out.shape) != in[0]->data.size()) {
+                throw std::runtime_error("NativeRunner: " + op + " '" + node.name + "' changes the element count");
+            }
+            kernel = _copy(*in[0], out);
+        } else if (op == "Concat") {
+            kernel = _compile_concat(node, in, out);
+        } else if (op == "Slice" || op == "Gather" || op == "Transpose" || op == "Expand") {
+            kernel = _compile_index_op(node, in, out);
+        } else {
+            throw std::runtime_error("NativeRunner: unsupported op " + op + " ('" + node.name + "')");
+        }
+
+        if (always_const) {
+            if (out.shape.empty() && out.data.size() != 1) out.shape = {static_cast<int64_t>(out.data.size())};
+            out.is_const = true;
+            return;
+        }
+
+        const bool foldable = std::all_of(in.begin(), in.end(), [](const Tensor* t) { return !t || t->is_const; });
+        if (foldable) {
+            kernel();
+            out.is_const = true;
+        } else {
+            program_.push_back(std::move(kernel));
+        }
+    }
+
+    // out = x * W^T + bias, with W packed row-major (N x K).
+    std::function<void()> _dense(const float* x, size_t rows, const RowMatrix* W, const RowMatrix* bias, float* o)
+    {
+        return [x, rows, W, bias, o]() {
+            Eigen::Map<const RowMatrix> X(x, rows, W->cols());
+            Eigen::Map<RowMatrix> O(o, rows, W->rows());
+            O.noalias() = X * W->transpose();
+            if (bias) O += *bias;
+        };
+    }
+
+    std::function<void()> _compile_gemm(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out)
+    {
+        const Tensor& A = *in[0];
+        const Tensor& B = *in[1];
+        const Tensor* C = in.size() > 2 ? in[2] : nullptr;
+        const bool transA = node.attr_i("transA", 0) != 0;
+        const bool transB = node.attr_i("transB", 0) != 0;
+        const float alpha = node.attr_f("alpha", 1.0f);
+        const float beta = node.attr_f("beta", 1.0f);
+        if (transA) throw std::runtime_error("NativeRunner: Gemm with transA is not supported");
+        if (!B.is_const) throw std::runtime_error("NativeRunner: Gemm with non-constant B is not supported");
+
+        const int64_t M = A.shape.at(0), K = A.shape.at(1);
+        const int64_t N = transB ? B.shape.at(0) : B.shape.at(1);
+        out.shape = {M, N};
+        out.data.assign(M * N, 0.0f);
+
+        weights_.emplace_back(N, K);
+        RowMatrix& W = weights_.back();
+        for (int64_t n = 0; n < N; ++n)
+            for (int64_t k = 0; k < K; ++k)
+                W(n, k) = alpha * (transB ? B.data[n * K + k] : B.data[k * N + n]);
+
+        const RowMatrix* bias = nullptr;
+        if (C) {
+            if (!C->is_const) throw std::runtime_error("NativeRunner: Gemm with non-constant C is not supported");
+            weights_.emplace_back(M, N);
+            RowMatrix& Bm = weights_.back();
+            const auto map = _broadcast_index(C->shape, out.shape);
+            for (int64_t i = 0; i < M * N; ++i) Bm.data()[i] = beta * C->data[map[i]];
+            bias = &Bm;
+        }
+        return _dense(A.data.data(), M, &W, bias, out.data.data());
+    }
+
+    std::function<void()> _compile_matmul(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out)
+    {
+        const Tensor& A = *in[0];
+        const Tensor& B = *in[1];
+        if (!B.is_const || B.shape.size() > 2) {
+            throw std::runtime_error("NativeRunner: MatMul needs a constant 1-D/2-D right operand ('" + node.name + "')");
+        }
+        const int64_t K = A.shape.back();
+        const int64_t N = B.shape.size() == 2 ? B.shape[1] : 1;
+        if ((B.shape.size() == 2 ? B.shape[0] : B.shape[0]) != K) throw std::runtime_error("NativeRunner: MatMul shape mismatch");
+        const size_t rows = A.data.size() / K;
+
+        out.shape.assign(A.shape.begin(), A.shape.end() - 1);
+        if (B.shape.size() == 2) out.shape.push_back(N);
+        out.data.assign(rows * N, 0.0f);
+
+        weights_.emplace_back(N, K);
+        RowMatrix& W = weights_.back();
+        for (int64_t n = 0; n < N; ++n)
+            for (int64_t k = 0; k < K; ++k)
+                W(n, k) = B.data[k * N + n];
+        return _dense(A.data.data(), rows, &W, nullptr, out.data.data());
+    }
+
+    // Pointwise (1x1, stride 1, no padding) convolution, grouped or not: per group O_g = W_g * X_g + b_g.
+    // As the experts of a MoE block, groups with a zero mix weight are skipped.
+    std::function<void()> _compile_conv(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out, MoeBlock* moe = nullptr)
+    {
+        const Tensor& X = *in[0];
+        const Tensor& Wt = _const_input(in, 1, node);
+        const Tensor* B = in.size() > 2 ? in[2] : nullptr;
+        const int64_t group = node.attr_i("group", 1);
+        for (size_t i = 2; i < Wt.shape.size(); ++i) {
+            if (Wt.shape[i] != 1) throw std::runtime_error("NativeRunner: only pointwise Conv is supported ('" + node.name + "')");
+        }
+        for (auto v : node.attr_ints("strides")) if (v != 1) throw std::runtime_error("NativeRunner: Conv strides must be 1");
+        for (auto v : node.attr_ints("pads")) if (v != 0) throw std::runtime_error("NativeRunner: Conv pads must be 0");
+
+        const int64_t batch = X.shape.at(0), cin = X.shape.at(1), cout = Wt.shape.at(0);
+        const int64_t spatial = static_cast<int64_t>(X.data.size()) / (batch * cin);
+        const int64_t cin_g = cin / group, cout_g = cout / group;
+        out.shape = X.shape;
+        out.shape[1] = cout;
+        out.data.assign(batch * cout * spatial, 0.0f);
+
+        if (moe) {
+            auto gate = values_by_name_.find(moe->gate);
+            std::string reason;
+            if (batch != 1 || spatial != 1) reason = "batch and spatial size must be 1";
+            else if (gate == values_by_name_.end()) reason = "the gate is computed after the experts";
+            else if (static_cast<int64_t>(gate->second->data.size()) != group) reason = "gate size differs from the expert count";
+            if (reason.empty()) {
+                moe->num_experts = group;
+                moe->weights = gate->second->data.data();
+                moe->mix.assign(group, 0.0f);
+                moe->order.resize(group);
+                spdlog::info("NativeRunner: sparse MoE on '{}': {} experts, top_k {}, threshold {}",
+                    moe->experts, group, moe_.top_k, moe_.threshold);
+            } else {
+                spdlog::warn("NativeRunner: MoE '{}' runs dense: {}", moe->experts, reason);
+                moe = nullptr;
+            }
+        }
+
+        std::vector<const RowMatrix*> Ws, Bs;
+        for (int64_t g = 0; g < group; ++g) {
+            weights_.emplace_back(cout_g, cin_g);
+            RowMatrix& W = weights_.back();
+            for (int64_t o = 0; o < cout_g; ++o)
+                for (int64_t i = 0; i < cin_g; ++i)
+                    W(o, i) = Wt.data[(g * cout_g + o) * cin_g + i];
+            Ws.push_back(&W);
+            if (B) {
+                weights_.emplace_back(cout_g, 1);
+                RowMatrix& b = weights_.back();
+                for (int64_t o = 0; o < cout_g; ++o) b(o, 0) = _const_input(in, 2, node).data[g * cout_g + o];
+                Bs.push_back(&b);
+            }
+        }
+
+        const float* x = X.data.data();
+        float* o = out.data.data();
+        return [=]() {
+            if (moe) _moe_select(*moe);
+            for (int64_t n = 0; n < batch; ++n) {
+                for (int64_t g = 0; g < group; ++g) {
+                    if (moe && moe->mix[g] == 0.0f) continue;
+                    Eigen::Map<const RowMatrix> Xg(x + (n * cin + g * cin_g) * spatial, cin_g, spatial);
+                    Eigen::Map<RowMatrix> Og(o + (n * cout + g * cout_g) * spatial, cout_g, spatial);
+                    Og.noalias() = *Ws[g] * Xg;
+                    if (!Bs.empty()) Og.colwise() += Bs[g]->col(0);
+                }
+            }
+        };
+    }
+
+    // gate * experts with the gate replaced by the block's mix weights; skipped experts contribute 0.
+    std::function<void()> _compile_moe_mix(const std::vector<Tensor*>& in, Tensor& out, MoeBlock& moe)
+    {
+        const Tensor& gate = *in[moe.gate_input];
+        const Tensor& x = *in[1 - moe.gate_input];
+        out.shape = _broadcast_shape(gate.shape, x.shape);
+        out.data.assign(_numel(out.shape), 0.0f);
+        auto ig = std::make_shared<std::vector<int32_t>>(_broadcast_index(gate.shape, out.shape));
+        auto ix = std::make_shared<std::vector<int32_t>>(_broadcast_index(x.shape, out.shape));
+        const float* mix = moe.mix.data();
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        const size_t n = out.data.size();
+        return [=]() {
+            for (size_t i = 0; i < n; ++i) {
+                const float m = mix[(*ig)[i]];
+                po[i] = m != 0.0f ? m * px[(*ix)[i]] : 0.0f;
+            }
+        };
+    }
+
+    template <typename Op>
+    std::function<void()> _binary(const Tensor& a, const Tensor& b, Tensor& out, Op op)
+    {
+        out.shape = _broadcast_shape(a.shape, b.shape);
+        out.is_int = a.is_int && b.is_int;
+        out.data.assign(_numel(out.shape), 0.0f);
+        const float* pa = a.data.data();
+        const float* pb = b.data.data();
+        float* po = out.data.data();
+        const size_t n = out.data.size();
+        if (a.data.size() == n && b.data.size() == n) {
+            return [=]() { for (size_t i = 0; i < n; ++i) po[i] = op(pa[i], pb[i]); };
+        }
+        if (b.data.size() == 1 && a.data.size() == n) {
+            return [=]() { const float s = pb[0]; for (size_t i = 0; i < n; ++i) po[i] = op(pa[i], s); };
+        }
+        auto ia = std::make_shared<std::vector<int32_t>>(_broadcast_index(a.shape, out.shape));
+        auto ib = std::make_shared<std::vector<int32_t>>(_broadcast_index(b.shape, out.shape));
+        return [=]() { for (size_t i = 0; i < n; ++i) po[i] = op(pa[(*ia)[i]], pb[(*ib)[i]]); };
+    }
+
+    template <typename Op>
+    std::function<void()> _unary(const Tensor& x, Tensor& out, Op op)
+    {
+        out.shape = x.shape;
+        out.is_int = x.is_int;
+        out.data.assign(x.data.size(), 0.0f);
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        const size_t n = out.data.size();
+        return [=]() { for (size_t i = 0; i < n; ++i) po[i] = op(px[i]); };
+    }
+
+    std::function<void()> _copy(const Tensor& x, Tensor& out)
+    {
+        out.data.assign(x.data.size(), 0.0f);
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        const size_t n = out.data.size();
+        return [=]() { std::copy(px, px + n, po); };
+    }
+
+    std::function<void()> _compile_softmax(const onnx::Node& node, const Tensor& x, Tensor& out, bool log)
+    {
+        out.shape = x.shape;
+        out.data.assign(x.data.size(), 0.0f);
+        const size_t rank = x.shape.size();
+        const int64_t axis = _axis(node.attr_i("axis", opset_ >= 13 ? -1 : 1), rank);
+        // Before opset 13 the input is coerced to 2-D at `axis`
+        size_t outer = 1, dim = 1, inner = 1;
+        for (size_t i = 0; i < rank; ++i) {
+            if (static_cast<int64_t>(i) < axis) outer *= x.shape[i];
+            else if (static_cast<int64_t>(i) == axis || opset_ < 13) dim *= x.shape[i];
+            else inner *= x.shape[i];
+        }
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        return [=]() {
+            for (size_t o = 0; o < outer; ++o) {
+                for (size_t in = 0; in < inner; ++in) {
+                    const size_t base = o * dim * inner + in;
+                    float max_v = -std::numeric_limits<float>::infinity();
+                    for (size_t d = 0; d < dim; ++d) max_v = std::max(max_v, px[base + d * inner]);
+                    float sum = 0.0f;
+                    for (size_t d = 0; d < dim; ++d) {
+                        const float e = std::exp(px[base + d * inner] - max_v);
+                        po[base + d * inner] = e;
+                        sum += e;
+                    }
+                    for (size_t d = 0; d < dim; ++d) {
+                        float& v = po[base + d * inner];
+                        v = log ? (px[base + d * inner] - max_v - std::log(sum)) : v / sum;
+                    }
+                }
+            }
+        };
+    }
+
+    std::function<void()> _compile_reduce(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out)
+    {
+        const Tensor& x = *in[0];
+        const std::string& op = node.op_type;
+        const size_t rank = x.shape.size();
+        auto axes = _axes(node, in, 1);
+        const bool keepdims = node.attr_i("keepdims", 1) != 0;
+        std::vector<bool> reduced(rank, axes.empty() && node.attr_i("noop_with_empty_axes", 0) == 0);
+        for (auto a : axes) reduced[_axis(a, rank)] = true;
+
+        std::vector<int64_t> kept_shape(rank);
+        for (size_t i = 0; i < rank; ++i) {
+            kept_shape[i] = reduced[i] ? 1 : x.shape[i];
+            if (!reduced[i] || keepdims) out.shape.push_back(kept_shape[i]);
+        }
+        out.is_int = x.is_int;
+        out.data.assign(_numel(kept_shape), 0.0f);
+
+        const auto kept_strides = _strides(kept_shape);
+        auto dst = std::make_shared<std::vector<int32_t>>(_index_map(x.shape, [&](const std::vector<int64_t>& idx) {
+            int64_t o = 0;
+            for (size_t i = 0; i < rank; ++i) if (!reduced[i]) o += idx[i] * kept_strides[i];
+            return o;
+        }));
+        const float count = static_cast<float>(x.data.size()) / std::max<size_t>(out.data.size(), 1);
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        const size_t n_in = x.data.size(), n_out = out.data.size();
+        const int mode = op == "ReduceSum" ? 0 : op == "ReduceMean" ? 1 : op == "ReduceMax" ? 2 : op == "ReduceMin" ? 3 : 4;
+        return [=]() {
+            const float init = mode == 2 ? -std::numeric_limits<float>::infinity()
+                : mode == 3 ? std::numeric_limits<float>::infinity() : 0.0f;
+            std::fill(po, po + n_out, init);
+            for (size_t i = 0; i < n_in; ++i) {
+                float& acc = po[(*dst)[i]];
+                const float v = px[i];
+                switch (mode) {
+                    case 2: acc = std::max(acc, v); break;
+                    case 3: acc = std::min(acc, v); break;
+                    case 4: acc += v * v; break;
+                    default: acc += v;
+                }
+            }
+            if (mode == 1) for (size_t i = 0; i < n_out; ++i) po[i] /= count;
+            if (mode == 4) for (size_t i = 0; i < n_out; ++i) po[i] = std::sqrt(po[i]);
+        };
+    }
+
+    std::vector<int64_t> _reshape_target(const onnx::Node& node, const std::vector<Tensor*>& in)
+    {
+        const auto& shape = in[0]->shape;
+        const std::string& op = node.op_type;
+        if (op == "Reshape") {
+            auto target = _as_ints(_const_input(in, 1, node));
+            const bool allowzero = node.attr_i("allowzero", 0) != 0;
+            int64_t known = 1, infer = -1;
+            for (size_t i = 0; i < target.size(); ++i) {
+                if (target[i] == 0 && !allowzero) target[i] = shape.at(i);
+                if (target[i] == -1) infer = i; else known *= target[i];
+            }
+            if (infer >= 0) target[infer] = static_cast<int64_t>(in[0]->data.size()) / known;
+            return target;
+        }
+        if (op == "Flatten") {
+            const int64_t axis = node.attr_i("axis", 1) < 0 ? node.attr_i("axis", 1) + shape.size() : node.attr_i("axis", 1);
+            int64_t a = 1, b = 1;
+            for (size_t i = 0; i < shape.size(); ++i) (static_cast<int64_t>(i) < axis ? a : b) *= shape[i];
+            return {a, b};
+        }
+        const auto axes = _axes(node, in, 1);
+        if (op == "Squeeze") {
+            std::vector<int64_t> target;
+            for (size_t i = 0; i < shape.size(); ++i) {
+                bool drop = axes.empty() ? shape[i] == 1 : false;
+                for (auto a : axes) if (_axis(a, shape.size()) == static_cast<int64_t>(i)) drop = true;
+                if (!drop) target.push_back(shape[i]);
+            }
+            return target;
+        }
+        // Unsqueeze
+        const size_t rank = shape.size() + axes.size();
+        std::vector<bool> inserted(rank, false);
+        for (auto a : axes) inserted[_axis(a, rank)] = true;
+        std::vector<int64_t> target;
+        size_t j = 0;
+        for (size_t i = 0; i < rank; ++i) target.push_back(inserted[i] ? 1 : shape[j++]);
+        return target;
+    }
+
+    std::function<void()> _compile_concat(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out)
+    {
+        const size_t rank = in[0]->shape.size();
+        const int64_t axis = _axis(node.attr_i("axis", 0), rank);
+        out.shape = in[0]->shape;
+        out.shape[axis] = 0;
+        out.is_int = true;
+        for (auto* t : in) {
+            out.shape[axis] += t->shape[axis];
+            out.is_int = out.is_int && t->is_int;
+        }
+        out.data.assign(_numel(out.shape), 0.0f);
+
+        size_t outer = 1;
+        for (int64_t i = 0; i < axis; ++i) outer *= out.shape[i];
+        std::vector<std::pair<const float*, size_t>> parts; // source, contiguous block per outer index
+        for (auto* t : in) parts.emplace_back(t->data.data(), outer ? t->data.size() / outer : 0);
+        float* po = out.data.data();
+        return [=]() {
+            float* dst = po;
+            for (size_t o = 0; o < outer; ++o) {
+                for (const auto& [src, block] : parts) {
+                    std::copy(src + o * block, src + (o + 1) * block, dst);
+                    dst += block;
+                }
+            }
+        };
+    }
+
+    // Pure data-movement ops: precompute the source element of every output element.
+    std::function<void()> _compile_index_op(const onnx::Node& node, const std::vector<Tensor*>& in, Tensor& out)
+    {
+        const Tensor& x = *in[0];
+        const std::string& op = node.op_type;
+        const size_t rank = x.shape.size();
+        const auto strides = _strides(x.shape);
+        out.is_int = x.is_int;
+        std::vector<int32_t> map;
+
+        if (op == "Slice") {
+            std::vector<int64_t> starts, ends, axes, steps;
+            if (opset_ < 10) {
+                starts = node.attr_ints("starts"); ends = node.attr_ints("ends"); axes = node.attr_ints("axes");
+            } else {
+                starts = _as_ints(_const_input(in, 1, node));
+                ends = _as_ints(_const_input(in, 2, node));
+                if (in.size() > 3 && in[3]) axes = _as_ints(_const_input(in, 3, node));
+                if (in.size() > 4 && in[4]) steps = _as_ints(_const_input(in, 4, node));
+            }
+            if (axes.empty()) { axes.resize(starts.size()); std::iota(axes.begin(), axes.end(), 0); }
+            std::vector<int64_t> begin(rank, 0), step(rank, 1);
+            out.shape = x.shape;
+            for (size_t i = 0; i < axes.size(); ++i) {
+                const int64_t a = _axis(axes[i], rank), dim = x.shape[a];
+                const int64_t s = steps.empty() ? 1 : steps[i];
+                int64_t b = starts[i] < 0 ? starts[i] + dim : starts[i];
+                int64_t e = ends[i] < 0 ? ends[i] + dim : std::min<int64_t>(ends[i], dim);
+                if (s > 0) { b = std::clamp<int64_t>(b, 0, dim); e = std::clamp<int64_t>(e, 0, dim); }
+                else { b = std::clamp<int64_t>(b, 0, dim - 1); e = std::clamp<int64_t>(e, -1, dim - 1); }
+                begin[a] = b;
+                step[a] = s;
+                out.shape[a] = std::max<int64_t>(0, s > 0 ? (e - b + s - 1) / s : (b - e - s - 1) / -s);
+            }
+            map = _index_map(out.shape, [&](const std::vector<int64_t>& idx) {
+                int64_t src = 0;
+                for (size_t i = 0; i < rank; ++i) src += (begin[i] + idx[i] * step[i]) * strides[i];
+                return src;
+            });
+        } else if (op == "Gather") {
+            const Tensor& indices = _const_input(in, 1, node);
+            const int64_t axis = _axis(node.attr_i("axis", 0), rank);
+            out.shape.assign(x.shape.begin(), x.shape.begin() + axis);
+            out.shape.insert(out.shape.end(), indices.shape.begin(), indices.shape.end());
+            out.shape.insert(out.shape.end(), x.shape.begin() + axis + 1, x.shape.end());
+            const size_t q = indices.shape.size();
+            map = _index_map(out.shape, [&](const std::vector<int64_t>& idx) {
+                int64_t flat = 0;
+                for (size_t i = 0; i < q; ++i) flat = flat * indices.shape[i] + idx[axis + i];
+                int64_t k = static_cast<int64_t>(indices.data[flat]);
+                if (k < 0) k += x.shape[axis];
+                int64_t src = k * strides[axis];
+                for (int64_t i = 0; i < axis; ++i) src += idx[i] * strides[i];
+                for (size_t i = axis + 1; i < rank; ++i) src += idx[i - 1 + q] * strides[i];
+                return src;
+            });
+        } else if (op == "Transpose") {
+            auto perm = node.attr_ints("perm");
+            if (perm.empty()) { perm.resize(rank); std::iota(perm.rbegin(), perm.rend(), 0); }
+            for (size_t i = 0; i < rank; ++i) out.shape.push_back(x.shape[perm[i]]);
+            map = _index_map(out.shape, [&](const std::vector<int64_t>& idx) {
+                int64_t src = 0;
+                for (size_t i = 0; i < rank; ++i) src += idx[i] * strides[perm[i]];
+                return src;
+            });
+        } else { // Expand
+            out.shape = _broadcast_shape(x.shape, _as_ints(_const_input(in, 1, node)));
+            map = _broadcast_index(x.shape, out.shape);
+        }
+
+        out.data.assign(_numel(out.shape), 0.0f);
+        auto shared_map = std::make_shared<std::vector<int32_t>>(std::move(map));
+        const float* px = x.data.data();
+        float* po = out.data.data();
+        return [=]() {
+            const auto& m = *shared_map;
+            for (size_t i = 0; i < m.size(); ++i) po[i] = px[m[i]];
+        };
+    }
+
+    int64_t opset_ = 0;
+    size_t num_params_ = 0;
+    std::deque<Tensor> values_;
+    std::unordered_map<std::string, Tensor*> values_by_name_;
+    std::deque<RowMatrix> weights_;
+    std::vector<std::function<void()>> program_;
+    MoeSparsity moe_;
+    bool moe_sparse_ = true;
+    std::deque<MoeBlock> moe_blocks_;
+
+    std::vector<std::string> input_names_;
+    std::vector<Tensor*> inputs_;
+    std::vector<std::string> output_names_;
+    std::vector<Tensor*> outputs_;
+    size_t action_index_ = 0;
+};
+
+};
@@ -0,0 +1,391 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Minimal reader for the subset of the ONNX protobuf schema needed to run exported policies natively:
+ * graph inputs/outputs, nodes with their attributes and (embedded) initializers.
+ * All numeric tensors are widened to float; `is_int` remembers integer/bool element types.
+ */
+namespace onnx
+{
+
+struct Tensor
+{
+    std::string name;
+    std::vector<int64_t> dims;
+    std::vector<float> data;
+    bool is_int = false;
+};
+
+struct Attribute
+{
+    std::string name;
+    float f = 0.0f;
+    int64_t i = 0;
+    std::string s;
+    std::vector<float> floats;
+    std::vector<int64_t> ints;
+    Tensor t;
+};
+
+struct Node
+{
+    std::string name;
+    std::string op_type;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::map<std::string, Attribute> attributes;
+
+    bool has(const std::string& key) const { return attributes.count(key) > 0; }
+    int64_t attr_i(const std::string& key, int64_t fallback) const { return has(key) ? attributes.at(key).i : fallback; }
+    float attr_f(const std::string& key, float fallback) const { return has(key) ? attributes.at(key).f : fallback; }
+    std::vector<int64_t> attr_ints(const std::string& key) const { return has(key) ? attributes.at(key).ints : std::vector<int64_t>{}; }
+};
+
+struct ValueInfo
+{
+    std::string name;
+    std::vector<int64_t> shape; // -1 for symbolic dims
+};
+
+struct Model
+{
+    int64_t opset = 0;
+    std::vector<Node> nodes;
+    std::map<std::string, Tensor> initializers;
+    std::vector<ValueInfo> inputs;
+    std::vector<ValueInfo> outputs;
+};
+
+namespace detail
+{
+
+class Reader
+{
+public:
+    Reader(const char* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    bool done() const { return p_ >= end_; }
+
+    uint64_t varint()
+    {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p_ >= end_) throw std::runtime_error("onnx: truncated varint");
+            const uint8_t byte = static_cast<uint8_t>(*p_++);
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return result;
+        }
+        throw std::runtime_error("onnx: malformed varint");
+    }
+
+    // Returns field number, sets wire type.
+    uint32_t tag(uint32_t& wire)
+    {
+        const uint64_t key = varint();
+        wire = static_cast<uint32_t>(key & 7);
+        return static_cast<uint32_t>(key >> 3);
+    }
+
+    Reader bytes()
+    {
+        const uint64_t len = varint();
+        if (static_cast<uint64_t>(end_ - p_) < len) throw std::runtime_error("onnx: truncated field");
+        Reader sub(p_, len);
+        p_ += len;
+        return sub;
+    }
+
+    std::string str() { Reader r = bytes(); return std::string(r.p_, r.end_); }
+
+    template <typename T>
+    T fixed()
+    {
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T)) throw std::runtime_error("onnx: truncated fixed field");
+        T value;
+        std::memcpy(&value, p_, sizeof(T));
+        p_ += sizeof(T);
+        return value;
+    }
+
+    void skip(uint32_t wire)
+    {
+        switch (wire) {
+            case 0: varint(); break;
+            case 1: p_ += 8; break;
+            case 2: bytes(); break;
+            case 5: p_ += 4; break;
+            default: throw std::runtime_error("onnx: unsupported wire type " + std::to_string(wire));
+        }
+    }
+
+    // Repeated scalar fields may be packed (wire 2) or not.
+    void varints(uint32_t wire, std::vector<int64_t>& out)
+    {
+        if (wire == 2) {
+            Reader r = bytes();
+            while (!r.done()) out.push_back(static_cast<int64_t>(r.varint()));
+        } else {
+            out.push_back(static_cast<int64_t>(varint()));
+        }
+    }
+
+    template <typename T>
+    void fixeds(uint32_t wire, std::vector<T>& out)
+    {
+        if (wire == 2) {
+            Reader r = bytes();
+            while (!r.done()) out.push_back(r.fixed<T>());
+        } else {
+            out.push_back(fixed<T>());
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+inline float half_to_float(uint16_t h)
+{
+    const uint32_t sign = (h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else { // subnormal
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400)) { mant <<= 1; --exp; }
+            bits = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+        }
+    } else if (exp == 31) {
+        bits = sign | 0x7f800000u | (mant << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline Tensor parse_tensor(Reader r)
+{
+    enum { FLOAT = 1, UINT8 = 2, INT8 = 3, UINT16 = 4, INT16 = 5, INT32 = 6, INT64 = 7, BOOL = 9, FLOAT16 = 10, DOUBLE = 11, UINT32 = 12, UINT64 = 13 };
+
+    Tensor t;
+    int64_t data_type = FLOAT;
+    std::string raw;
+    std::vector<float> float_data;
+    std::vector<double> double_data;
+    std::vector<int64_t> int_data;
+    bool external = false;
+    while (!r.done()) {
+        uint32_t wire;
+        switch (r.tag(wire)) {
+            case 1: r.varints(wire, t.dims); break;
+            case 2: data_type = static_cast<int64_t>(r.varint()); break;
+            case 4: r.fixeds<float>(wire, float_data); break;
+            case 5: case 7: case 11: r.varints(wire, int_data); break;
+            case 8: t.name = r.str(); break;
+            case 9: raw = r.str(); break;
+            case 10: r.fixeds<double>(wire, double_data); break;
+            case 14: external = r.varint() == 1; break;
+            default: r.skip(wire);
+        }
+    }
+    if (external) throw std::runtime_error("onnx: tensor '" + t.name + "' uses external data, which is not supported");
+
+    std::size_t count = 1;
+    for (auto d : t.dims) count *= static_cast<std::size_t>(d);
+    t.is_int = data_type != FLOAT && data_type != FLOAT16 && data_type != DOUBLE;
+    t.data.reserve(count);
+
+    if (!raw.empty()) {
+        const char* p = raw.data();
+        auto read = [&](auto tag) {
+            using T = decltype(tag);
+            if (raw.size() < count * sizeof(T)) throw std::runtime_error("onnx: tensor '" + t.name + "' raw data too short");
+            for (std::size_t i = 0; i < count; ++i) {
+                T v;
+                std::memcpy(&v, p + i * sizeof(T), sizeof(T));
+                t.data.push_back(static_cast<float>(v));
+            }
+        };
+        switch (data_type) {
+            case FLOAT: read(float{}); break;
+            case DOUBLE: read(double{}); break;
+            case INT64: read(int64_t{}); break;
+            case INT32: read(int32_t{}); break;
+            case INT16: read(int16_t{}); break;
+            case UINT16: read(uint16_t{}); break;
+            case INT8: read(int8_t{}); break;
+            case UINT8: case BOOL: read(uint8_t{}); break;
+            case UINT32: read(uint32_t{}); break;
+            case UINT64: read(uint64_t{}); break;
+            case FLOAT16:
+                if (raw.size() < count * 2) throw std::runtime_error("onnx: tensor '" + t.name + "' raw data too short");
+                for (std::size_t i = 0; i < count; ++i) {
+                    uint16_t h;
+                    std::memcpy(&h, p + i * 2, 2);
+                    t.data.push_back(half_to_float(h));
+                }
+                break;
+            default: throw std::runtime_error("onnx: tensor '" + t.name + "' has unsupported data type " + std::to_string(data_type));
+        }
+    } else if (data_type == FLOAT) {
+        t.data = std::move(float_data);
+    } else if (data_type == DOUBLE) {
+        t.data.assign(double_data.begin(), double_data.end());
+    } else if (data_type == FLOAT16) {
+        for (auto v : int_data) t.data.push_back(half_to_float(static_cast<uint16_t>(v)));
+    } else {
+        for (auto v : int_data) t.data.push_back(static_cast<float>(v));
+    }
+    if (t.data.size() != count) {
+        throw std::runtime_error("onnx: tensor '" + t.name + "' holds " + std::to_string(t.data.size())
+            + " values, expected " + std::to_string(count));
+    }
+    return t;
+}
+
+inline Attribute parse_attribute(Reader r)
+{
+    Attribute a;
+    while (!r.done()) {
+        uint32_t wire;
+        switch (r.tag(wire)) {
+            case 1: a.name = r.str(); break;
+            case 2: a.f = r.fixed<float>(); break;
+            case 3: a.i = static_cast<int64_t>(r.varint()); break;
+            case 4: a.s = r.str(); break;
+            case 5: a.t = parse_tensor(r.bytes()); break;
+            case 7: r.fixeds<float>(wire, a.floats); break;
+            case 8: r.varints(wire, a.ints); break;
+            default: r.skip(wire);
+        }
+    }
+    return a;
+}
+
+inline Node parse_node(Reader r)
+{
+    Node n;
+    while (!r.done()) {
+        uint32_t wire;
+        switch (r.tag(wire)) {
+            case 1: n.inputs.push_back(r.str()); break;
+            case 2: n.outputs.push_back(r.str()); break;
+            case 3: n.name = r.str(); break;
+            case 4: n.op_type = r.str(); break;
+            case 5: { auto a = parse_attribute(r.bytes()); n.attributes[a.name] = std::move(a); break; }
+            default: r.skip(wire);
+        }
+    }
+    return n;
+}
+
+inline ValueInfo parse_value_info(Reader r)
+{
+    ValueInfo v;
+    while (!r.done()) {
+        uint32_t wire;
+        const uint32_t field = r.tag(wire);
+        if (field == 1) { v.name = r.str(); continue; }
+        if (field != 2) { r.skip(wire); continue; }
+        // TypeProto.tensor_type(1).shape(2).dim(1).{dim_value(1) | dim_param(2)}
+        Reader type = r.bytes();
+        while (!type.done()) {
+            uint32_t w1;
+            if (type.tag(w1) != 1) { type.skip(w1); continue; }
+            Reader tensor = type.bytes();
+            while (!tensor.done()) {
+                uint32_t w2;
+                if (tensor.tag(w2) != 2) { tensor.skip(w2); continue; }
+                Reader shape = tensor.bytes();
+                while (!shape.done()) {
+                    uint32_t w3;
+                    if (shape.tag(w3) != 1) { shape.skip(w3); continue; }
+                    Reader dim = shape.bytes();
+                    int64_t value = -1;
+                    while (!dim.done()) {
+                        uint32_t w4;
+                        if (dim.tag(w4) == 1) value = static_cast<int64_t>(dim.varint());
+                        else dim.skip(w4);
+                    }
+                    v.shape.push_back(value);
+                }
+            }
+        }
+    }
+    return v;
+}
+
+} // namespace detail
+
+inline Model load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("onnx: cannot open " + path);
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Model model;
+    detail::Reader r(bytes.data(), bytes.size());
+    std::vector<ValueInfo> graph_inputs;
+    while (!r.done()) {
+        uint32_t wire;
+        const uint32_t field = r.tag(wire);
+        if (field == 8) { // opset_import
+            detail::Reader op = r.bytes();
+            std::string domain;
+            int64_t version = 0;
+            while (!op.done()) {
+                uint32_t w;
+                const uint32_t f = op.tag(w);
+                if (f == 1) domain = op.str();
+                else if (f == 2) version = static_cast<int64_t>(op.varint());
+                else op.skip(w);
+            }
+            if (domain.empty() || domain == "ai.onnx") model.opset = version;
+        } else if (field == 7) { // graph
+            detail::Reader g = r.bytes();
+            while (!g.done()) {
+                uint32_t w;
+                switch (g.tag(w)) {
+                    case 1: model.nodes.push_back(detail::parse_node(g.bytes())); break;
+                    case 5: { auto t = detail::parse_tensor(g.bytes()); model.initializers[t.name] = std::move(t); break; }
+                    case 11: graph_inputs.push_back(detail::parse_value_info(g.bytes())); break;
+                    case 12: model.outputs.push_back(detail::parse_value_info(g.bytes())); break;
+                    default: g.skip(w);
+                }
+            }
+        } else {
+            r.skip(wire);
+        }
+    }
+
+    // Older exporters list initializers as graph inputs too
+    for (auto& input : graph_inputs) {
+        if (!model.initializers.count(input.name)) model.inputs.push_back(std::move(input));
+    }
+    if (model.nodes.empty()) throw std::runtime_error("onnx: no graph found in " + path);
+    return model;
+}
+
+} // namespace onnx
+
+};
@@ -0,0 +1,217 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "isaaclab/algorithms/algorithms.h"
+#include "isaaclab/algorithms/native_runner.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <filesystem>
+#include <random>
+
+namespace isaaclab
+{
+
+/**
+ * Policy backend selection.
+ *
+ * deploy.yaml (or the state's entry in config.yaml, which takes precedence):
+ *   policy_backend: ort            # ort | native
+ *   io_binding: false              # ort only
+ *   native_parity_check: true      # compare native against ORT at load time
+ *   native_parity_tol: 1.0e-4      # max |native - ort| / max(1, |ort|)
+ *   moe_sparse: {top_k: 2, threshold: 0.05, tol: 0.05}  # native only, see MoeSparsity
+ *   quantization: {mode: int8}     # ort only, see quantization.h
+ *   onnx_providers: [CPU]          # ort only, provider / threading keys of session_config.h
+ *
+ * With `native`, a failed parity check or an unsupported graph falls back to OrtRunner. The parity check runs
+ * the experts densely; sparse MoE execution is then compared against dense and stays off if it exceeds `tol`.
+ */
+struct PolicyOptions
+{
+    std::string backend = "ort";
+    bool io_binding = false;
+    bool parity_check = true;
+    float parity_tol = 1e-4f;
+    MoeSparsity moe;
+    QuantizationConfig quantization;
+    SessionConfig session;
+
+    // `policy_dir` anchors relative paths (onnx_trt_cache_dir).
+    static PolicyOptions from(const YAML::Node& state_cfg, const YAML::Node& deploy_cfg, const std::filesystem::path& policy_dir = {})
+    {
+        PolicyOptions opts;
+        opts.apply(deploy_cfg, policy_dir);
+        opts.apply(state_cfg, policy_dir);
+        return opts;
+    }
+
+    // Override the options set in `cfg`.
+    void apply(const YAML::Node& cfg, const std::filesystem::path& policy_dir = {})
+    {
+        if (!cfg || !cfg.IsMap()) return;
+        session.apply(cfg, policy_dir);
+        if (cfg["policy_backend"]) backend = cfg["policy_backend"].as<std::string>();
+        if (cfg["io_binding"]) io_binding = cfg["io_binding"].as<bool>();
+        if (cfg["native_parity_check"]) parity_check = cfg["native_parity_check"].as<bool>();
+        if (cfg["native_parity_tol"]) parity_tol = cfg["native_parity_tol"].as<float>();
+        if (const auto moe_cfg = cfg["moe_sparse"]) {
+            if (moe_cfg["top_k"]) moe.top_k = moe_cfg["top_k"].as<int>();
+            if (moe_cfg["threshold"]) moe.threshold = moe_cfg["threshold"].as<float>();
+            if (moe_cfg["tol"]) moe.tol = moe_cfg["tol"].as<float>();
+        }
+        if (cfg["quantization"]) quantization = QuantizationConfig::from(cfg["quantization"]);
+    }
+};
+
+namespace detail
+{
+
+struct LatencyStats
+{
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+};
+
+inline LatencyStats measure_latency(
+    Algorithms& alg, const std::unordered_map<std::string, std::vector<float>>& obs, int iterations = 200)
+{
+    using clock = std::chrono::steady_clock;
+    std::map<std::string, std::vector<float>> results;
+    std::vector<double> samples(iterations);
+    alg.forward_into(obs, results);
+    for (auto& s : samples) {
+        const auto t0 = clock::now();
+        alg.forward_into(obs, results);
+        s = std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+    }
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[std::min(samples.size() - 1, samples.size() * 99 / 100)], samples.back()};
+}
+
+// Largest error of `native` against `ort` over zero and random inputs, scaled by max(1, |ort|).
+inline float parity_error(NativeRunner& native, OrtRunner& ort, std::unordered_map<std::string, std::vector<float>>& obs)
+{
+    std::mt19937 rng(0);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    float max_err = 0.0f;
+    for (int trial = 0; trial < 8; ++trial) {
+        for (size_t i = 0; i < native.input_names().size(); ++i) {
+            auto& x = obs[native.input_names()[i]];
+            x.resize(std::accumulate(native.input_shape(i).begin(), native.input_shape(i).end(), size_t(1), std::multiplies<size_t>()));
+            for (auto& v : x) v = trial == 0 ? 0.0f : dist(rng);
+        }
+        auto expected = ort.forward(obs);
+        auto actual = native.forward(obs);
+        for (const auto& [name, ref] : expected) {
+            const auto& out = actual.at(name);
+            if (out.size() != ref.size()) return std::numeric_limits<float>::infinity();
+            for (size_t j = 0; j < ref.size(); ++j) {
+                max_err = std::max(max_err, std::abs(out[j] - ref[j]) / std::max(1.0f, std::abs(ref[j])));
+            }
+        }
+    }
+    return max_err;
+}
+
+// Largest error of sparse against dense MoE execution over the same inputs as parity_error.
+inline float moe_sparse_error(NativeRunner& native, std::unordered_map<std::string, std::vector<float>>& obs)
+{
+    std::mt19937 rng(0);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    float max_err = 0.0f;
+    for (int trial = 0; trial < 8; ++trial) {
+        for (size_t i = 0; i < native.input_names().size(); ++i) {
+            auto& x = obs[native.input_names()[i]];
+            x.resize(std::accumulate(native.input_shape(i).begin(), native.input_shape(i).end(), size_t(1), std::multiplies<size_t>()));
+            for (auto& v : x) v = trial == 0 ? 0.0f : dist(rng);
+        }
+        native.set_moe_sparse(false);
+        auto expected = native.forward(obs);
+        native.set_moe_sparse(true);
+        auto actual = native.forward(obs);
+        for (const auto& [name, ref] : expected) {
+            const auto& out = actual.at(name);
+            for (size_t j = 0; j < ref.size(); ++j) {
+                max_err = std::max(max_err, std::abs(out[j] - ref[j]) / std::max(1.0f, std::abs(ref[j])));
+            }
+        }
+    }
+    return max_err;
+}
+
+// Turn on sparse MoE execution of `native` if it stays within `moe.tol` of dense execution.
+inline void enable_moe_sparse(NativeRunner& native, const MoeSparsity& moe, const std::filesystem::path& model_path)
+{
+    std::unordered_map<std::string, std::vector<float>> obs;
+    const float err = moe_sparse_error(native, obs);
+    const double experts = native.moe_active_experts();
+    native.set_moe_sparse(false);
+    const auto dense = measure_latency(native, obs);
+    native.set_moe_sparse(true);
+    const auto sparse = measure_latency(native, obs);
+    native.reset_moe_counters();
+    spdlog::info("NativeRunner: {} sparse MoE ran {:.2f} experts/step on test inputs, error vs dense {:.2e} (tol {:.1e}), "
+        "latency p50/p99 sparse {:.1f}/{:.1f}us, dense {:.1f}/{:.1f}us", model_path.filename().string(), experts, err, moe.tol,
+        sparse.p50_us, sparse.p99_us, dense.p50_us, dense.p99_us);
+    if (!(err <= moe.tol)) {
+        spdlog::error("NativeRunner: sparse MoE of {} exceeds moe_sparse.tol, running all experts.", model_path.string());
+        native.set_moe_sparse(false);
+    }
+}
+
+}
+
+inline std::unique_ptr<Algorithms> make_policy(const std::filesystem::path& model_path, const PolicyOptions& opts)
+{
+    if (opts.backend == "ort") {
+        if (opts.moe.enabled()) spdlog::warn("OrtRunner: moe_sparse needs policy_backend: native, running {} dense.", model_path.string());
+        return std::make_unique<OrtRunner>(model_path.string(), opts.io_binding, opts.quantization, opts.session);
+    }
+    if (opts.backend != "native") {
+        throw std::runtime_error("Unknown policy_backend '" + opts.backend + "' (expected ort or native).");
+    }
+
+    if (opts.quantization.enabled()) {
+        spdlog::warn("NativeRunner: quantization applies to the ort backend only, running {} in FP32.", model_path.string());
+    }
+    std::unique_ptr<NativeRunner> native;
+    try {
+        native = std::make_unique<NativeRunner>(model_path.string(), opts.moe);
+    } catch (const std::exception& e) {
+        spdlog::warn("NativeRunner: cannot run {}: {}. Falling back to ORT.", model_path.string(), e.what());
+        return std::make_unique<OrtRunner>(model_path.string(), opts.io_binding, opts.quantization, opts.session);
+    }
+    const bool sparse = opts.moe.enabled() && native->moe_blocks() > 0;
+    native->set_moe_sparse(false);
+    if (!opts.parity_check) {
+        if (sparse) detail::enable_moe_sparse(*native, opts.moe, model_path);
+        return native;
+    }
+
+    // The reference session comes straight from the Env so the check leaves no ort_cache file, autotune
+    // result, shared or profiled session behind.
+    auto& runtime = InferenceRuntime::instance();
+    Ort::SessionOptions reference_options;
+    runtime.apply(reference_options);
+    OrtRunner ort(std::make_shared<Ort::Session>(runtime.env(), model_path.string().c_str(), reference_options), true);
+    std::unordered_map<std::string, std::vector<float>> obs;
+    const float err = detail::parity_error(*native, ort, obs);
+    const auto native_latency = detail::measure_latency(*native, obs);
+    const auto ort_latency = detail::measure_latency(ort, obs);
+    spdlog::info("NativeRunner: {} parity error {:.2e} (tol {:.1e}), latency p50/p99 native {:.1f}/{:.1f}us, ort {:.1f}/{:.1f}us",
+        model_path.filename().string(), err, opts.parity_tol,
+        native_latency.p50_us, native_latency.p99_us, ort_latency.p50_us, ort_latency.p99_us);
+
+    if (!(err <= opts.parity_tol)) {
+        spdlog::error("NativeRunner: parity check failed for {}. Falling back to ORT.", model_path.string());
+        return std::make_unique<OrtRunner>(model_path.string(), opts.io_binding, opts.quantization, opts.session);
+    }
+    if (sparse) detail::enable_moe_sparse(*native, opts.moe, model_path);
+    return native;
+}
+
+};
@@ -0,0 +1,158 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Per-op-type and per-node latency summary of an ORT profile (the JSON written by EnableProfiling).
+ *
+ * Only `Node` events are counted, and the first model_run is skipped as warmup. Times are averaged per
+ * model_run, so they read as "microseconds this op costs every policy step".
+ */
+class ProfileSummary
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        std::string op_type;
+        std::string provider;
+        double total_us = 0.0;
+        long calls = 0;
+    };
+
+    static ProfileSummary parse(const std::filesystem::path& json_path)
+    {
+        std::ifstream file(json_path);
+        if (!file) throw std::runtime_error("cannot open " + json_path.string());
+        const auto events = nlohmann::json::parse(file);
+        if (!events.is_array()) throw std::runtime_error("unexpected profile format");
+
+        ProfileSummary summary;
+        summary.path_ = json_path;
+
+        // Runs in order; node events before the end of the first one belong to the warmup run
+        std::vector<std::pair<double, double>> runs;
+        for (const auto& e : events) {
+            if (e.value("cat", "") == "Session" && e.value("name", "") == "model_run") {
+                runs.emplace_back(e.value("ts", 0.0), e.value("dur", 0.0));
+            }
+        }
+        std::sort(runs.begin(), runs.end());
+        const double warmup_end = runs.empty() ? 0.0 : runs.front().first + runs.front().second;
+        summary.runs_ = runs.size() > 1 ? static_cast<long>(runs.size()) - 1 : static_cast<long>(runs.size());
+        for (size_t i = runs.size() > 1 ? 1 : 0; i < runs.size(); ++i) summary.run_us_ += runs[i].second;
+
+        std::map<std::string, Entry> nodes;
+        for (const auto& e : events) {
+            if (e.value("cat", "") != "Node" || (runs.size() > 1 && e.value("ts", 0.0) < warmup_end)) continue;
+            std::string name = e.value("name", "");
+            const std::string suffix = "_kernel_time";
+            if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue; // fence_before / fence_after
+            }
+            name.resize(name.size() - suffix.size());
+            auto& node = nodes[name];
+            node.name = name;
+            if (e.contains("args")) {
+                node.op_type = e["args"].value("op_name", "");
+                node.provider = e["args"].value("provider", "");
+            }
+            node.total_us += e.value("dur", 0.0);
+            node.calls += 1;
+        }
+
+        std::map<std::string, Entry> ops;
+        for (const auto& [name, node] : nodes) {
+            summary.nodes_.push_back(node);
+            auto& op = ops[node.op_type];
+            op.name = op.op_type = node.op_type;
+            op.total_us += node.total_us;
+            op.calls += node.calls;
+            summary.node_us_ += node.total_us;
+        }
+        for (const auto& [name, op] : ops) summary.ops_.push_back(op);
+
+        auto by_time = [](const Entry& a, const Entry& b) { return a.total_us > b.total_us; };
+        std::sort(summary.nodes_.begin(), summary.nodes_.end(), by_time);
+        std::sort(summary.ops_.begin(), summary.ops_.end(), by_time);
+        return summary;
+    }
+
+    // Human-readable report: per-op-type table, then the `top_nodes` slowest nodes.
+    std::string report(size_t top_nodes = 20) const
+    {
+        const double runs = std::max<long>(runs_, 1);
+        std::ostringstream ss;
+        ss << "profile: " << path_.filename().string() << "\n"
+           << "runs: " << runs_ << " (first run excluded as warmup)\n"
+           << "model_run avg: " << fmt(run_us_ / runs) << " us, node kernels avg: " << fmt(node_us_ / runs) << " us\n\n";
+
+        ss << pad("op_type", 28) << pad("nodes/run", 12) << pad("us/run", 12) << "share\n";
+        for (const auto& op : ops_) {
+            ss << pad(op.op_type, 28) << pad(fmt(op.calls / runs), 12) << pad(fmt(op.total_us / runs), 12)
+               << fmt(share(op.total_us)) << "%\n";
+        }
+
+        ss << "\n" << pad("node", 48) << pad("op_type", 20) << pad("provider", 26) << pad("us/run", 12) << "share\n";
+        for (size_t i = 0; i < std::min(top_nodes, nodes_.size()); ++i) {
+            const auto& node = nodes_[i];
+            ss << pad(node.name, 48) << pad(node.op_type, 20) << pad(node.provider, 26)
+               << pad(fmt(node.total_us / runs), 12) << fmt(share(node.total_us)) << "%\n";
+        }
+        return ss.str();
+    }
+
+    // One line with the `count` most expensive op types, for the log.
+    std::string hot_ops(size_t count = 5) const
+    {
+        std::string line;
+        for (size_t i = 0; i < std::min(count, ops_.size()); ++i) {
+            line += (line.empty() ? "" : ", ") + ops_[i].op_type + " " + fmt(share(ops_[i].total_us)) + "%";
+        }
+        return line;
+    }
+
+    long runs() const { return runs_; }
+    const std::vector<Entry>& ops() const { return ops_; }
+    const std::vector<Entry>& nodes() const { return nodes_; }
+
+private:
+    double share(double us) const { return node_us_ > 0.0 ? 100.0 * us / node_us_ : 0.0; }
+
+    static std::string fmt(double value)
+    {
+        std::ostringstream ss;
+        ss.setf(std::ios::fixed);
+        ss.precision(value < 10.0 ? 2 : 1);
+        ss << value;
+        return ss.str();
+    }
+
+    static std::string pad(const std::string& s, size_t width)
+    {
+        return s.size() + 1 >= width ? s + " " : s + std::string(width - s.size(), ' ');
+    }
+
+    std::filesystem::path path_;
+    long runs_ = 0;
+    double run_us_ = 0.0;
+    double node_us_ = 0.0;
+    std::vector<Entry> ops_;
+    std::vector<Entry> nodes_;
+};
+
+};
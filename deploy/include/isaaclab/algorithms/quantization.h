@@ -0,0 +1,496 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "onnxruntime_cxx_api.h"
+#include "isaaclab/algorithms/inference_runtime.h"
+#include "isaaclab/algorithms/onnx_model.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <random>
+#include <set>
+
+namespace isaaclab
+{
+
+/**
+ * Optional INT8 execution of a policy session.
+ *
+ * On first load the FP32 model is rewritten with dynamic quantization (weights int8 per output column,
+ * activations quantized per call by DynamicQuantizeLinear, MatMulInteger for the product) and cached as
+ * <cache dir>/<stem>.<model hash>.int8[r]-w<min_weight_size>.onnx. Before the quantized session replaces the
+ * FP32 one, both run on the same observations and the quantized model is refused if any action differs by
+ * more than `max_action_error`.
+ *
+ *   quantization:
+ *     mode: none             # none | int8
+ *     max_action_error: 0.05 # gate threshold on raw network outputs
+ *     gate_samples: 64       # synthetic observations (zeros + N(0, 1))
+ *     gate_data: ""          # optional DataLogger csv with columns <input>_<i>, used instead of synthetic data
+ *     min_weight_size: 4096  # smaller MatMul/Gemm weights stay FP32
+ *     reduce_range: false    # 7-bit weights (x86 without VNNI)
+ */
+struct QuantizationConfig
+{
+    std::string mode = "none";
+    float max_action_error = 0.05f;
+    int gate_samples = 64;
+    std::string gate_data;
+    size_t min_weight_size = 4096;
+    bool reduce_range = false; // 7-bit weights, for x86 CPUs without VNNI where u8s8 products can saturate
+
+    bool enabled() const { return mode != "none"; }
+
+    static QuantizationConfig from(const YAML::Node& cfg)
+    {
+        QuantizationConfig q;
+        if (!cfg || !cfg.IsMap()) return q;
+        if (cfg["mode"]) q.mode = cfg["mode"].as<std::string>();
+        if (cfg["max_action_error"]) q.max_action_error = cfg["max_action_error"].as<float>();
+        if (cfg["gate_samples"]) q.gate_samples = cfg["gate_samples"].as<int>();
+        if (cfg["gate_data"] && !cfg["gate_data"].IsNull()) q.gate_data = cfg["gate_data"].as<std::string>();
+        if (cfg["min_weight_size"]) q.min_weight_size = cfg["min_weight_size"].as<size_t>();
+        if (cfg["reduce_range"]) q.reduce_range = cfg["reduce_range"].as<bool>();
+        if (q.mode != "none" && q.mode != "int8") {
+            throw std::runtime_error("quantization.mode must be none or int8, got '" + q.mode + "'");
+        }
+        return q;
+    }
+};
+
+namespace onnx
+{
+namespace detail
+{
+
+class Writer
+{
+public:
+    void varint(uint64_t v)
+    {
+        while (v >= 0x80) { buf.push_back(static_cast<char>((v & 0x7f) | 0x80)); v >>= 7; }
+        buf.push_back(static_cast<char>(v));
+    }
+    void tag(uint32_t field, uint32_t wire) { varint((static_cast<uint64_t>(field) << 3) | wire); }
+    void bytes(uint32_t field, const std::string& s) { tag(field, 2); varint(s.size()); buf += s; }
+    void integer(uint32_t field, int64_t v) { tag(field, 0); varint(static_cast<uint64_t>(v)); }
+
+    std::string buf;
+};
+
+inline std::string write_tensor(const std::string& name, const std::vector<int64_t>& dims, int32_t data_type, const std::string& raw)
+{
+    Writer w;
+    for (auto d : dims) w.integer(1, d);
+    w.integer(2, data_type);
+    w.bytes(8, name);
+    w.bytes(9, raw);
+    return w.buf;
+}
+
+inline std::string write_node(
+    const std::string& op_type, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+    const std::string& name, const std::vector<std::pair<std::string, int64_t>>& int_attributes = {})
+{
+    Writer w;
+    for (const auto& in : inputs) w.bytes(1, in);
+    for (const auto& out : outputs) w.bytes(2, out);
+    w.bytes(3, name);
+    w.bytes(4, op_type);
+    for (const auto& [key, value] : int_attributes) {
+        Writer a;
+        a.bytes(1, key);
+        a.integer(3, value);
+        a.integer(20, 2); // AttributeProto.INT
+        w.bytes(5, a.buf);
+    }
+    return w.buf;
+}
+
+template <typename T>
+std::string raw_bytes(const std::vector<T>& values)
+{
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+} // namespace detail
+
+/**
+ * Rewrite MatMul/Gemm nodes with large constant weights into their dynamically quantized form, the same
+ * pattern onnxruntime.quantization.quantize_dynamic emits (ORT fuses it into DynamicQuantizeMatMul).
+ * Everything else in the model is copied through byte for byte. Returns the number of rewritten nodes.
+ */
+inline int quantize_dynamic_int8(const std::string& model_bytes, std::string& out, size_t min_weight_size, bool reduce_range)
+{
+    enum { FLOAT = 1, INT8 = 3 };
+    using detail::Reader;
+    using detail::Writer;
+
+    // Locate the graph and collect the initializers that can be quantized
+    Reader model(model_bytes.data(), model_bytes.size());
+    std::string graph_bytes;
+    int64_t opset = 0;
+    while (!model.done()) {
+        uint32_t wire;
+        const uint32_t field = model.tag(wire);
+        if (field == 7) {
+            Reader g = model.bytes();
+            graph_bytes.assign(g.p_, g.end_);
+        } else if (field == 8) {
+            Reader op = model.bytes();
+            std::string domain;
+            int64_t version = 0;
+            while (!op.done()) {
+                uint32_t w;
+                const uint32_t f = op.tag(w);
+                if (f == 1) domain = op.str();
+                else if (f == 2) version = static_cast<int64_t>(op.varint());
+                else op.skip(w);
+            }
+            if (domain.empty() || domain == "ai.onnx") opset = version;
+        } else {
+            model.skip(wire);
+        }
+    }
+    if (graph_bytes.empty()) throw std::runtime_error("onnx: no graph found");
+    if (opset < 11) throw std::runtime_error("onnx: dynamic quantization needs opset >= 11, model has " + std::to_string(opset));
+
+    std::map<std::string, Tensor> weights;
+    std::map<std::string, int> uses;
+    {
+        Reader g(graph_bytes.data(), graph_bytes.size());
+        while (!g.done()) {
+            uint32_t w;
+            switch (g.tag(w)) {
+                case 1: for (const auto& in : detail::parse_node(g.bytes()).inputs) ++uses[in]; break;
+                case 5: {
+                    Reader t = g.bytes();
+                    Reader probe = t;
+                    int64_t data_type = FLOAT, dims = 0;
+                    while (!probe.done()) {
+                        uint32_t pw;
+                        const uint32_t f = probe.tag(pw);
+                        if (f == 2) data_type = static_cast<int64_t>(probe.varint());
+                        else if (f == 1) { std::vector<int64_t> d; probe.varints(pw, d); dims += d.size(); }
+                        else probe.skip(pw);
+                    }
+                    if (data_type == FLOAT && dims == 2) {
+                        auto tensor = detail::parse_tensor(t);
+                        if (tensor.data.size() >= min_weight_size) weights[tensor.name] = std::move(tensor);
+                    }
+                    break;
+                }
+                default: g.skip(w);
+            }
+        }
+    }
+
+    const float qmax = reduce_range ? 63.0f : 127.0f;
+    std::set<std::string> consumed;
+    std::vector<std::string> new_initializers;
+    int rewritten = 0;
+
+    // Quantize W[K, N] symmetrically per column into <prefix>_quantized / _scale / _zero_point initializers.
+    auto add_weight = [&](const std::string& prefix, const std::vector<float>& W, int64_t K, int64_t N) {
+        std::vector<float> scale(N, 0.0f);
+        for (int64_t k = 0; k < K; ++k)
+            for (int64_t n = 0; n < N; ++n) scale[n] = std::max(scale[n], std::abs(W[k * N + n]));
+        for (auto& s : scale) s = s > 0.0f ? s / qmax : 1.0f;
+        std::vector<int8_t> q(K * N);
+        for (int64_t k = 0; k < K; ++k)
+            for (int64_t n = 0; n < N; ++n)
+                q[k * N + n] = static_cast<int8_t>(std::clamp(std::round(W[k * N + n] / scale[n]), -qmax, qmax));
+        new_initializers.push_back(detail::write_tensor(prefix + "_quantized", {K, N}, INT8, detail::raw_bytes(q)));
+        new_initializers.push_back(detail::write_tensor(prefix + "_scale", {N}, FLOAT, detail::raw_bytes(scale)));
+        new_initializers.push_back(detail::write_tensor(prefix + "_zero_point", {}, INT8, std::string(1, '\0')));
+    };
+
+    auto rewrite = [&](const Node& node, std::string& nodes_out) -> bool {
+        const bool gemm = node.op_type == "Gemm";
+        if (!gemm && node.op_type != "MatMul") return false;
+        if (node.inputs.size() < 2 || !weights.count(node.inputs[1])) return false;
+        const Tensor& B = weights.at(node.inputs[1]);
+        const float alpha = gemm ? node.attr_f("alpha", 1.0f) : 1.0f;
+        const float beta = gemm ? node.attr_f("beta", 1.0f) : 1.0f;
+        const bool transB = gemm && node.attr_i("transB", 0) != 0;
+        const std::string bias = gemm && node.inputs.size() > 2 ? node.inputs[2] : "";
+        if (gemm && node.attr_i("transA", 0) != 0) return false;
+        if (!bias.empty() && beta != 1.0f) return false;
+
+        const int64_t K = transB ? B.dims[1] : B.dims[0];
+        const int64_t N = transB ? B.dims[0] : B.dims[1];
+        std::vector<float> W(K * N);
+        for (int64_t k = 0; k < K; ++k)
+            for (int64_t n = 0; n < N; ++n)
+                W[k * N + n] = alpha * (transB ? B.data[n * K + k] : B.data[k * N + n]);
+
+        const std::string p = (node.name.empty() ? node.outputs[0] : node.name) + "_int8";
+        add_weight(p + "/W", W, K, N);
+        const std::string& y = node.outputs[0];
+        const std::string scaled = bias.empty() ? y : p + "/y_no_bias";
+        auto emit = [&](const std::string& n) { Writer w; w.bytes(1, n); nodes_out += w.buf; };
+        emit(detail::write_node("DynamicQuantizeLinear", {node.inputs[0]}, {p + "/x_q", p + "/x_scale", p + "/x_zero_point"}, p + "/quantize"));
+        emit(detail::write_node("MatMulInteger", {p + "/x_q", p + "/W_quantized", p + "/x_zero_point", p + "/W_zero_point"}, {p + "/y_int32"}, p + "/matmul"));
+        emit(detail::write_node("Cast", {p + "/y_int32"}, {p + "/y_float"}, p + "/cast", {{"to", FLOAT}}));
+        emit(detail::write_node("Mul", {p + "/x_scale", p + "/W_scale"}, {p + "/scale"}, p + "/scale_mul"));
+        emit(detail::write_node("Mul", {p + "/y_float", p + "/scale"}, {scaled}, p + "/rescale"));
+        if (!bias.empty()) {
+            emit(detail::write_node("Add", {scaled, bias}, {y}, p + "/bias_add"));
+        }
+        consumed.insert(node.inputs[1]);
+        ++rewritten;
+        return true;
+    };
+
+    // Re-emit the graph: rewritten nodes in place, FP32 weights that are no longer used dropped
+    std::string nodes;
+    std::string rest;
+    {
+        Reader g(graph_bytes.data(), graph_bytes.size());
+        while (!g.done()) {
+            const char* field_begin = g.p_;
+            uint32_t w;
+            const uint32_t field = g.tag(w);
+            if (field == 1) {
+                Reader n = g.bytes();
+                if (!rewrite(detail::parse_node(n), nodes)) nodes.append(field_begin, g.p_);
+            } else {
+                g.skip(w);
+                rest.append(field_begin, g.p_);
+            }
+        }
+    }
+    std::set<std::string> dropped;
+    for (const auto& name : consumed) {
+        if (--uses[name] <= 0) dropped.insert(name);
+    }
+
+    Writer graph;
+    graph.buf = nodes;
+    {
+        Reader g(rest.data(), rest.size());
+        while (!g.done()) {
+            const char* field_begin = g.p_;
+            uint32_t w;
+            const uint32_t field = g.tag(w);
+            if (field == 5 || field == 11) {
+                // initializer (TensorProto.name = 8) or graph input (ValueInfoProto.name = 1)
+                Reader item = g.bytes();
+                std::string name;
+                while (!item.done()) {
+                    uint32_t iw;
+                    const uint32_t f = item.tag(iw);
+                    if ((field == 5 && f == 8) || (field == 11 && f == 1)) name = item.str();
+                    else item.skip(iw);
+                }
+                if (dropped.count(name)) continue;
+            } else {
+                g.skip(w);
+            }
+            graph.buf.append(field_begin, g.p_);
+        }
+    }
+    for (const auto& init : new_initializers) graph.bytes(5, init);
+
+    Writer result;
+    model = Reader(model_bytes.data(), model_bytes.size());
+    while (!model.done()) {
+        const char* field_begin = model.p_;
+        uint32_t wire;
+        const uint32_t field = model.tag(wire);
+        model.skip(wire);
+        if (field == 7) result.bytes(7, graph.buf);
+        else result.buf.append(field_begin, model.p_);
+    }
+    out = std::move(result.buf);
+    return rewritten;
+}
+
+} // namespace onnx
+
+namespace detail
+{
+
+// Observations for the gate: rows of a DataLogger csv (columns <input>_<i>) or synthetic N(0, 1) samples.
+inline std::vector<std::vector<std::vector<float>>> gate_observations(
+    const QuantizationConfig& q, const std::vector<std::string>& names, const std::vector<size_t>& sizes)
+{
+    std::vector<std::vector<std::vector<float>>> samples;
+    if (!q.gate_data.empty()) {
+        std::ifstream file(q.gate_data);
+        if (!file) throw std::runtime_error("cannot open gate_data " + q.gate_data);
+        std::string line;
+        std::getline(file, line);
+        std::map<std::string, size_t> column;
+        {
+            std::stringstream ss(line);
+            std::string key;
+            for (size_t i = 0; std::getline(ss, key, ','); ++i) column[key] = i;
+        }
+        std::vector<std::vector<size_t>> index(names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            for (size_t j = 0; j < sizes[i]; ++j) {
+                auto it = column.find(names[i] + "_" + std::to_string(j));
+                if (it == column.end()) throw std::runtime_error("gate_data has no column " + names[i] + "_" + std::to_string(j));
+                index[i].push_back(it->second);
+            }
+        }
+        while (std::getline(file, line)) {
+            std::vector<float> row;
+            std::stringstream ss(line);
+            std::string cell;
+            while (std::getline(ss, cell, ',')) row.push_back(std::strtof(cell.c_str(), nullptr));
+            auto& sample = samples.emplace_back(names.size());
+            for (size_t i = 0; i < names.size(); ++i)
+                for (auto c : index[i]) sample[i].push_back(c < row.size() ? row[c] : 0.0f);
+        }
+        return samples;
+    }
+
+    std::mt19937 rng(0);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (int s = 0; s < std::max(q.gate_samples, 1); ++s) {
+        auto& sample = samples.emplace_back(names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            sample[i].resize(sizes[i]);
+            for (auto& v : sample[i]) v = s == 0 ? 0.0f : dist(rng);
+        }
+    }
+    return samples;
+}
+
+// Largest difference between the two sessions' "actions" output (all float outputs if there is none).
+inline float max_action_error(Ort::Session& reference, Ort::Session& candidate, const QuantizationConfig& q)
+{
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<std::string> input_names, output_names;
+    std::vector<std::vector<int64_t>> shapes;
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < reference.GetInputCount(); ++i) {
+        auto info = reference.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo();
+        if (info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+            throw std::runtime_error("accuracy gate supports float inputs only");
+        }
+        auto shape = info.GetShape();
+        size_t size = 1;
+        for (auto& d : shape) { if (d < 0) d = 1; size *= d; }
+        input_names.push_back(reference.GetInputNameAllocated(i, allocator).get());
+        shapes.push_back(shape);
+        sizes.push_back(size);
+    }
+    for (size_t i = 0; i < reference.GetOutputCount(); ++i) {
+        output_names.push_back(reference.GetOutputNameAllocated(i, allocator).get());
+    }
+    if (std::find(output_names.begin(), output_names.end(), "actions") != output_names.end()) {
+        output_names = {"actions"};
+    }
+
+    std::vector<const char*> in_ptrs, out_ptrs;
+    for (const auto& n : input_names) in_ptrs.push_back(n.c_str());
+    for (const auto& n : output_names) out_ptrs.push_back(n.c_str());
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+    float max_err = 0.0f;
+    for (auto& sample : gate_observations(q, input_names, sizes)) {
+        std::vector<Ort::Value> inputs;
+        for (size_t i = 0; i < sample.size(); ++i) {
+            inputs.push_back(Ort::Value::CreateTensor<float>(
+                memory_info, sample[i].data(), sample[i].size(), shapes[i].data(), shapes[i].size()));
+        }
+        auto expected = reference.Run(Ort::RunOptions{nullptr}, in_ptrs.data(), inputs.data(), inputs.size(), out_ptrs.data(), out_ptrs.size());
+        auto actual = candidate.Run(Ort::RunOptions{nullptr}, in_ptrs.data(), inputs.data(), inputs.size(), out_ptrs.data(), out_ptrs.size());
+        for (size_t o = 0; o < expected.size(); ++o) {
+            const size_t count = expected[o].GetTensorTypeAndShapeInfo().GetElementCount();
+            const float* e = expected[o].GetTensorData<float>();
+            const float* a = actual[o].GetTensorData<float>();
+            for (size_t j = 0; j < count; ++j) max_err = std::max(max_err, std::abs(e[j] - a[j]));
+        }
+    }
+    return max_err;
+}
+
+} // namespace detail
+
+/**
+ * Swap `fp32` for its INT8 variant when quantization is enabled and the variant passes the accuracy gate.
+ * `session` / `providers` are the config `fp32` was created with and the provider that took effect.
+ * Only CPU sessions are quantized; GPU providers keep FP32 (TensorRT has its own fp16 switch).
+ */
+inline std::shared_ptr<Ort::Session> quantize_session(
+    std::shared_ptr<Ort::Session> fp32, const std::string& model_path, const std::string& owner,
+    const QuantizationConfig& q, const SessionConfig& session = {}, const std::string& providers = "CPU")
+{
+    namespace fs = std::filesystem;
+    if (!q.enabled()) return fp32;
+    if (providers != "CPU") {
+        spdlog::info("{}: quantization skipped for {} (providers={})", owner, model_path, providers);
+        return fp32;
+    }
+
+    auto& runtime = InferenceRuntime::instance();
+    try {
+        std::ifstream file(model_path, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open model");
+        const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const fs::path cache_dir = runtime.cache_dir(model_path);
+        const std::string stem = fs::path(model_path).stem().string();
+        // Both quantizer settings change the output, so a cached file only matches the same pair.
+        const std::string tag = ".int8" + std::string(q.reduce_range ? "r" : "") + "-w" + std::to_string(q.min_weight_size) + ".onnx";
+        const fs::path quantized_path = cache_dir / (stem + "." + InferenceRuntime::content_hash(bytes) + tag);
+
+        if (!fs::exists(quantized_path)) {
+            std::string quantized;
+            const int count = onnx::quantize_dynamic_int8(bytes, quantized, q.min_weight_size, q.reduce_range);
+            if (count == 0) {
+                spdlog::info("{}: no MatMul/Gemm weights to quantize in {}", owner, model_path);
+                return fp32;
+            }
+            std::error_code ec;
+            fs::create_directories(cache_dir, ec);
+            for (const auto& entry : fs::directory_iterator(cache_dir, ec)) {
+                const std::string name = entry.path().filename().string();
+                if (name.rfind(stem + ".", 0) == 0 && name.find(".int8") != std::string::npos
+                    && fs::path(name).extension() == ".onnx") {
+                    fs::remove(entry.path(), ec); // quantized from an older model file or with other settings
+                }
+            }
+            const fs::path tmp_path = quantized_path.string() + ".tmp";
+            {
+                std::ofstream out(tmp_path, std::ios::binary);
+                out.write(quantized.data(), quantized.size());
+                out.close();
+                if (!out) {
+                    fs::remove(tmp_path, ec);
+                    throw std::runtime_error("cannot write " + tmp_path.string());
+                }
+            }
+            fs::rename(tmp_path, quantized_path);
+            spdlog::info("{}: quantized {} MatMul/Gemm nodes of {} to int8", owner, count, model_path);
+        }
+
+        Ort::SessionOptions options;
+        std::shared_ptr<Ort::Session> int8;
+        try {
+            int8 = runtime.create_session(quantized_path.string(), options, owner + "/int8", session);
+        } catch (const std::exception&) {
+            std::error_code ec;
+            fs::remove(quantized_path, ec); // truncated or stale, quantize again next time
+            throw;
+        }
+        const float err = detail::max_action_error(*fp32, *int8, q);
+        if (err > q.max_action_error) {
+            spdlog::error("{}: int8 model refused, max action error {:.4f} > {:.4f}. Using FP32.", owner, err, q.max_action_error);
+            return fp32;
+        }
+        spdlog::info("{}: using int8 model (max action error {:.4f} <= {:.4f})", owner, err, q.max_action_error);
+        return int8;
+    } catch (const std::exception& e) {
+        spdlog::error("{}: quantization of {} failed: {}. Using FP32.", owner, model_path, e.what());
+        return fp32;
+    }
+}
+
+};
@@ -0,0 +1,199 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "onnxruntime_cxx_api.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Execution provider and tuning options of one ONNX Runtime session.
+ *
+ * Read from a state's entry in config.yaml (OrtRunner also reads deploy.yaml, the state entry wins):
+ *   onnx_providers: [TensorRT, CUDA, CPU]  # preference order, the first available one is used
+ *   onnx_cuda_device: 0
+ *   onnx_trt_fp16: true
+ *   onnx_trt_cache_dir: trt_cache          # relative to policy_dir; empty disables the engine cache
+ *   onnx_intra_op_threads: 2               # any of the three thread keys gives the session its own pools;
+ *   onnx_inter_op_threads: 1               #   unset keys fall back to the `inference` section
+ *   onnx_allow_spinning: false
+ *   onnx_execution_mode: sequential        # sequential | parallel
+ *   onnx_graph_optimization: extended      # disable | basic | extended | all
+ *   onnx_autotune: true                    # overrides inference.autotune for this state (autotune.h)
+ *   onnx_profile_steps: 500                # ORT profiling of the first N runs, summarized by profiler.h
+ *   onnx_profile_dir: logs                 # relative to policy_dir
+ *
+ * The older `onnx_tensorrt` / `onnx_cuda` switches still add or remove those providers.
+ */
+struct SessionConfig
+{
+    std::vector<std::string> providers = {"CPU"};
+    int device_id = 0;
+    bool trt_fp16 = false;
+    std::string trt_cache_dir;
+    int intra_op_num_threads = 0;
+    int inter_op_num_threads = 0;
+    int allow_spinning = -1; // -1: inherit
+    ExecutionMode execution_mode = ORT_SEQUENTIAL;
+    GraphOptimizationLevel opt_level = ORT_ENABLE_EXTENDED;
+    int autotune = -1; // -1: inherit
+    int profile_steps = 0;
+    std::string profile_dir = "logs";
+
+    static SessionConfig from(const YAML::Node& cfg, SessionConfig defaults, const std::filesystem::path& base_dir = {})
+    {
+        defaults.apply(cfg, base_dir);
+        return defaults;
+    }
+
+    // Override the options set in `cfg`.
+    void apply(const YAML::Node& cfg, const std::filesystem::path& base_dir = {})
+    {
+        if (!cfg || !cfg.IsMap()) return;
+        if (cfg["onnx_providers"]) {
+            providers = cfg["onnx_providers"].as<std::vector<std::string>>();
+            for (const auto& p : providers) {
+                if (p != "TensorRT" && p != "CUDA" && p != "CPU") {
+                    throw std::runtime_error("SessionConfig: unknown provider '" + p + "' (expected TensorRT, CUDA or CPU).");
+                }
+            }
+        } else if (cfg["onnx_tensorrt"] || cfg["onnx_cuda"]) {
+            const bool trt = cfg["onnx_tensorrt"] ? cfg["onnx_tensorrt"].as<bool>() : has_provider("TensorRT");
+            const bool cuda = cfg["onnx_cuda"] ? cfg["onnx_cuda"].as<bool>() : has_provider("CUDA");
+            providers.clear();
+            if (trt) providers.push_back("TensorRT");
+            if (cuda) providers.push_back("CUDA");
+            providers.push_back("CPU");
+        }
+        if (cfg["onnx_cuda_device"]) device_id = cfg["onnx_cuda_device"].as<int>();
+        if (cfg["onnx_trt_fp16"]) trt_fp16 = cfg["onnx_trt_fp16"].as<bool>();
+        if (cfg["onnx_trt_cache_dir"]) {
+            trt_cache_dir = cfg["onnx_trt_cache_dir"].IsNull() ? "" : cfg["onnx_trt_cache_dir"].as<std::string>();
+        }
+        if (!trt_cache_dir.empty() && !base_dir.empty() && std::filesystem::path(trt_cache_dir).is_relative()) {
+            trt_cache_dir = (base_dir / trt_cache_dir).string();
+        }
+        if (cfg["onnx_intra_op_threads"]) intra_op_num_threads = cfg["onnx_intra_op_threads"].as<int>();
+        if (cfg["onnx_inter_op_threads"]) inter_op_num_threads = cfg["onnx_inter_op_threads"].as<int>();
+        if (cfg["onnx_allow_spinning"]) allow_spinning = cfg["onnx_allow_spinning"].as<bool>() ? 1 : 0;
+        if (cfg["onnx_execution_mode"]) {
+            const auto mode = cfg["onnx_execution_mode"].as<std::string>();
+            if (mode != "sequential" && mode != "parallel") {
+                throw std::runtime_error("SessionConfig: onnx_execution_mode must be sequential or parallel.");
+            }
+            execution_mode = mode == "parallel" ? ORT_PARALLEL : ORT_SEQUENTIAL;
+        }
+        if (cfg["onnx_graph_optimization"]) {
+            opt_level = opt_level_from(cfg["onnx_graph_optimization"].as<std::string>());
+        }
+        if (cfg["onnx_profile_steps"]) profile_steps = cfg["onnx_profile_steps"].as<int>();
+        if (cfg["onnx_profile_dir"]) profile_dir = cfg["onnx_profile_dir"].as<std::string>();
+        if (!base_dir.empty() && std::filesystem::path(profile_dir).is_relative()) {
+            profile_dir = (base_dir / profile_dir).string();
+        }
+        if (cfg["onnx_autotune"]) autotune = cfg["onnx_autotune"].as<bool>() ? 1 : 0;
+    }
+
+    bool has_provider(const std::string& name) const
+    {
+        return std::find(providers.begin(), providers.end(), name) != providers.end();
+    }
+
+    // The session runs on its own thread pools instead of the shared ones.
+    bool per_session_threads() const
+    {
+        return intra_op_num_threads > 0 || inter_op_num_threads > 0 || allow_spinning >= 0;
+    }
+
+    /**
+     * Append the first available provider of the preference list to `options`.
+     * Returns "TensorRT", "CUDA" or "CPU" (CPU is always available).
+     */
+    std::string append_providers(Ort::SessionOptions& options, const std::string& owner) const
+    {
+        const auto available = available_providers();
+        auto is_available = [&](const char* name) {
+            return std::find(available.begin(), available.end(), name) != available.end();
+        };
+        const OrtApi& api = Ort::GetApi();
+
+        for (const auto& provider : providers)
+        {
+            OrtStatus* status = nullptr;
+            if (provider == "TensorRT") {
+                if (!is_available("TensorrtExecutionProvider")) continue;
+                if (!trt_cache_dir.empty()) std::filesystem::create_directories(trt_cache_dir);
+                OrtTensorRTProviderOptions trt_options{};
+                trt_options.device_id = device_id;
+                trt_options.trt_max_partition_iterations = 1000;
+                trt_options.trt_min_subgraph_size = 1;
+                trt_options.trt_fp16_enable = trt_fp16 ? 1 : 0;
+                trt_options.trt_engine_cache_enable = trt_cache_dir.empty() ? 0 : 1;
+                trt_options.trt_engine_cache_path = trt_cache_dir.empty() ? nullptr : trt_cache_dir.c_str();
+                status = api.SessionOptionsAppendExecutionProvider_TensorRT(options, &trt_options);
+            } else if (provider == "CUDA") {
+                if (!is_available("CUDAExecutionProvider")) continue;
+                OrtCUDAProviderOptions cuda_options{};
+                cuda_options.device_id = device_id;
+                status = api.SessionOptionsAppendExecutionProvider_CUDA(options, &cuda_options);
+            } else {
+                return "CPU";
+            }
+            if (status == nullptr) return provider;
+            spdlog::warn("{}: append {} provider failed: {}", owner, provider, api.GetErrorMessage(status));
+            api.ReleaseStatus(status);
+        }
+        if (providers.empty() || providers.back() != "CPU") {
+            spdlog::warn("{}: none of the preferred providers is available, falling back to CPU", owner);
+        }
+        return "CPU";
+    }
+
+    static std::vector<std::string> available_providers()
+    {
+        const OrtApi& api = Ort::GetApi();
+        char** names = nullptr;
+        int count = 0;
+        OrtStatus* status = api.GetAvailableProviders(&names, &count);
+        if (status != nullptr) {
+            spdlog::warn("SessionConfig: GetAvailableProviders failed: {}", api.GetErrorMessage(status));
+            api.ReleaseStatus(status);
+            return {};
+        }
+        std::vector<std::string> result(names, names + count);
+        OrtStatus* release_status = api.ReleaseAvailableProviders(names, count);
+        if (release_status != nullptr) api.ReleaseStatus(release_status);
+        return result;
+    }
+
+    static GraphOptimizationLevel opt_level_from(const std::string& name)
+    {
+        if (name == "disable") return ORT_DISABLE_ALL;
+        if (name == "basic") return ORT_ENABLE_BASIC;
+        if (name == "extended") return ORT_ENABLE_EXTENDED;
+        if (name == "all") return ORT_ENABLE_ALL;
+        throw std::runtime_error("SessionConfig: onnx_graph_optimization must be disable, basic, extended or all.");
+    }
+
+    static const char* opt_level_name(GraphOptimizationLevel level)
+    {
+        switch (level)
+        {
+        case ORT_DISABLE_ALL: return "disable";
+        case ORT_ENABLE_BASIC: return "basic";
+        case ORT_ENABLE_EXTENDED: return "extended";
+        default: return "all";
+        }
+    }
+};
+
+};
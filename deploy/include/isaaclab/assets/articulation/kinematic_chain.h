@@ -0,0 +1,185 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include <eigen3/Eigen/Dense>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Serial chain of revolute/fixed joints from a base link to a tip link.
+ *
+ * forward() returns the tip pose in world frame given the base pose and the joint angles, in the order the
+ * chain was built with. Built from a URDF (joint origins and axes) or, for G1, the waist chain used by
+ * State_Mimic (pelvis -> torso_link: yaw Z, roll X, pitch Y).
+ */
+class KinematicChain
+{
+public:
+    struct Joint
+    {
+        std::string name;
+        Eigen::Vector3f origin_pos = Eigen::Vector3f::Zero();
+        Eigen::Quaternionf origin_rot = Eigen::Quaternionf::Identity();
+        Eigen::Vector3f axis = Eigen::Vector3f::UnitZ();
+        int q_index = -1; // -1: fixed joint
+    };
+
+    struct Pose
+    {
+        Eigen::Vector3f pos;
+        Eigen::Quaternionf quat;
+    };
+
+    static KinematicChain g1_waist()
+    {
+        KinematicChain chain;
+        const std::vector<std::pair<std::string, Eigen::Vector3f>> joints = {
+            {"waist_yaw_joint", Eigen::Vector3f::UnitZ()},
+            {"waist_roll_joint", Eigen::Vector3f::UnitX()},
+            {"waist_pitch_joint", Eigen::Vector3f::UnitY()},
+        };
+        for (const auto& [name, axis] : joints) {
+            Joint j;
+            j.name = name;
+            j.axis = axis;
+            j.q_index = static_cast<int>(chain.num_dofs_++);
+            chain.joints_.push_back(j);
+        }
+        return chain;
+    }
+
+    /**
+     * Read the chain `base_link` -> `tip_link` from a URDF. `dof_names` gives the order of the joint angles
+     * passed to forward(); movable joints of the chain missing from it throw.
+     */
+    static KinematicChain from_urdf(
+        const std::string& path, const std::string& base_link, const std::string& tip_link,
+        const std::vector<std::string>& dof_names)
+    {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("KinematicChain: cannot open " + path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        const std::string urdf = ss.str();
+
+        struct UrdfJoint { std::string name, type, parent; Joint joint; };
+        std::map<std::string, UrdfJoint> by_child;
+
+        const std::regex joint_re(R"(<joint\b([^>]*)>([\s\S]*?)</joint>)");
+        for (auto it = std::sregex_iterator(urdf.begin(), urdf.end(), joint_re); it != std::sregex_iterator(); ++it) {
+            const std::string head = (*it)[1], body = (*it)[2];
+            UrdfJoint u;
+            u.name = _attr(head, "name");
+            u.type = _attr(head, "type");
+            u.parent = _attr(_element(body, "parent"), "link");
+            const std::string child = _attr(_element(body, "child"), "link");
+            u.joint.name = u.name;
+
+            const std::string origin = _element(body, "origin");
+            const auto xyz = _vec3(_attr(origin, "xyz"));
+            const auto rpy = _vec3(_attr(origin, "rpy"));
+            u.joint.origin_pos = xyz;
+            u.joint.origin_rot = Eigen::AngleAxisf(rpy.z(), Eigen::Vector3f::UnitZ())
+                * Eigen::AngleAxisf(rpy.y(), Eigen::Vector3f::UnitY())
+                * Eigen::AngleAxisf(rpy.x(), Eigen::Vector3f::UnitX());
+            const std::string axis = _attr(_element(body, "axis"), "xyz");
+            const Eigen::Vector3f axis_vec = axis.empty() ? Eigen::Vector3f::UnitX() : _vec3(axis);
+            u.joint.axis = axis_vec.norm() > 0.0f ? axis_vec.normalized() : Eigen::Vector3f::UnitX();
+            by_child[child] = u;
+        }
+
+        KinematicChain chain;
+        std::string link = tip_link;
+        while (link != base_link) {
+            auto it = by_child.find(link);
+            if (it == by_child.end()) {
+                throw std::runtime_error("KinematicChain: no joint chain from " + base_link + " to " + tip_link + " in " + path);
+            }
+            chain.joints_.insert(chain.joints_.begin(), it->second.joint);
+            if (it->second.type != "fixed") {
+                auto name_it = std::find(dof_names.begin(), dof_names.end(), it->second.name);
+                if (name_it == dof_names.end()) {
+                    throw std::runtime_error("KinematicChain: joint " + it->second.name + " is not in the dof list");
+                }
+                if (it->second.type != "revolute" && it->second.type != "continuous") {
+                    throw std::runtime_error("KinematicChain: unsupported joint type " + it->second.type);
+                }
+                chain.joints_.front().q_index = static_cast<int>(name_it - dof_names.begin());
+            }
+            link = it->second.parent;
+        }
+        chain.num_dofs_ = dof_names.size();
+        return chain;
+    }
+
+    /**
+     * fk_chain:
+     *   urdf: resources/g1_29dof.urdf   # relative to the project dir; omit for the built-in G1 waist chain
+     *   base_link: pelvis
+     *   tip_link: torso_link
+     *   joints: [waist_yaw_joint, waist_roll_joint, waist_pitch_joint]
+     */
+    static KinematicChain from_yaml(const YAML::Node& cfg, const std::string& root_dir = "")
+    {
+        if (!cfg || !cfg["urdf"]) return g1_waist();
+        std::string path = cfg["urdf"].as<std::string>();
+        if (!root_dir.empty() && !path.empty() && path.front() != '/') path = root_dir + "/" + path;
+        return from_urdf(path, cfg["base_link"].as<std::string>(), cfg["tip_link"].as<std::string>(),
+                         cfg["joints"].as<std::vector<std::string>>());
+    }
+
+    Pose forward(const Eigen::Vector3f& base_pos, const Eigen::Quaternionf& base_quat, const float* q) const
+    {
+        Pose pose{base_pos, base_quat};
+        for (const auto& j : joints_) {
+            pose.pos += pose.quat * j.origin_pos;
+            pose.quat = pose.quat * j.origin_rot;
+            if (j.q_index >= 0) pose.quat = pose.quat * Eigen::Quaternionf(Eigen::AngleAxisf(q[j.q_index], j.axis));
+        }
+        pose.quat.normalize();
+        return pose;
+    }
+
+    size_t num_dofs() const { return num_dofs_; }
+    const std::vector<Joint>& joints() const { return joints_; }
+
+private:
+    static std::string _attr(const std::string& text, const std::string& key)
+    {
+        const std::regex re("\\b" + key + R"re(\s*=\s*"([^"]*)")re");
+        std::smatch m;
+        return std::regex_search(text, m, re) ? m[1].str() : std::string();
+    }
+
+    static std::string _element(const std::string& body, const std::string& tag)
+    {
+        const std::regex re("<" + tag + R"(\b([^>]*)/?>)");
+        std::smatch m;
+        return std::regex_search(body, m, re) ? m[1].str() : std::string();
+    }
+
+    static Eigen::Vector3f _vec3(const std::string& text)
+    {
+        Eigen::Vector3f v = Eigen::Vector3f::Zero();
+        std::istringstream ss(text);
+        ss >> v.x() >> v.y() >> v.z();
+        return v;
+    }
+
+    std::vector<Joint> joints_;
+    size_t num_dofs_ = 0;
+};
+
+};
@@ -0,0 +1,124 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include "isaaclab/manager/observation_manager.h"
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace isaaclab
+{
+
+/**
+ * Skips policy inference while the observations are quasi-static (robot standing, no command).
+ *
+ * Read from a state's entry in config.yaml:
+ *   adaptive_inference:
+ *     threshold: 0.02          # infer when any element of the newest obs frame moved more than this since the last inference
+ *     max_skip: 10             # infer at least every N+1 steps
+ *     command_terms: [velocity_commands]  # any change of these terms forces inference (default: terms named *command*)
+ *     log_interval: 60         # seconds between counter logs
+ *
+ * The metric is the max absolute difference of the newest scaled frame of every observation term against the
+ * frame used by the last inference. While inference is skipped the previous action is held.
+ */
+class AdaptiveInference
+{
+public:
+    static std::unique_ptr<AdaptiveInference> from(const YAML::Node& cfg, float step_dt)
+    {
+        if (!cfg || !cfg.IsMap()) return nullptr;
+        auto adaptive = std::make_unique<AdaptiveInference>();
+        if (cfg["threshold"]) adaptive->threshold_ = cfg["threshold"].as<float>();
+        if (cfg["max_skip"]) adaptive->max_skip_ = cfg["max_skip"].as<int>();
+        if (cfg["command_terms"]) adaptive->command_terms_ = cfg["command_terms"].as<std::vector<std::string>>();
+        const float log_interval = cfg["log_interval"] ? cfg["log_interval"].as<float>() : 60.0f;
+        adaptive->log_every_ = std::max(1L, static_cast<long>(log_interval / step_dt));
+        spdlog::info("AdaptiveInference: threshold {}, max_skip {}", adaptive->threshold_, adaptive->max_skip_);
+        return adaptive;
+    }
+
+    ~AdaptiveInference() { if (total_) _log(); }
+
+    // Force the next inference (after a reset).
+    void reset() { last_.clear(); commands_.clear(); skipped_ = 0; }
+
+    // Whether this step must run inference; called after the observations of the step were computed.
+    bool should_infer(const ObservationManager& obs)
+    {
+        ++total_;
+        bool first = last_.empty();
+        bool command = false;
+        bool resized = false; // a term changed size: nothing to compare against
+        float change = 0.0f;
+        size_t k = 0;
+        obs.for_each_latest([&](const std::string& name, const FrameView& frame) {
+            if (first) {
+                last_.emplace_back(frame.begin(), frame.end());
+                commands_.push_back(_is_command(name));
+                return;
+            }
+            const auto& ref = last_[k];
+            if (ref.size() != frame.size()) {
+                resized = true;
+                ++k;
+                return;
+            }
+            for (size_t i = 0; i < frame.size(); ++i) {
+                const float d = std::abs(frame[i] - ref[i]);
+                if (commands_[k] && d > 0.0f) command = true;
+                change = std::max(change, d);
+            }
+            ++k;
+        });
+
+        const bool infer = first || resized || command || change > threshold_ || skipped_ >= max_skip_;
+        if (infer) {
+            if (!first && (resized || command || change > threshold_)) ++forced_;
+            if (!first) {
+                k = 0;
+                obs.for_each_latest([&](const std::string&, const FrameView& frame) {
+                    last_[k++].assign(frame.begin(), frame.end());
+                });
+            }
+            skipped_ = 0;
+        } else {
+            ++skipped_;
+            ++skipped_total_;
+        }
+        if (total_ % log_every_ == 0) _log();
+        return infer;
+    }
+
+private:
+    bool _is_command(const std::string& name) const
+    {
+        if (command_terms_.empty()) return name.find("command") != std::string::npos;
+        return std::find(command_terms_.begin(), command_terms_.end(), name) != command_terms_.end();
+    }
+
+    void _log() const
+    {
+        spdlog::info("AdaptiveInference: {} steps, {} skipped ({:.1f}%), {} forced by change or command",
+            total_, skipped_total_, 100.0 * skipped_total_ / std::max(1L, total_), forced_);
+    }
+
+    float threshold_ = 0.02f;
+    int max_skip_ = 10;
+    std::vector<std::string> command_terms_;
+    long log_every_ = 3000;
+
+    std::vector<std::vector<float>> last_;
+    std::vector<bool> commands_;
+    int skipped_ = 0;
+    long total_ = 0;
+    long skipped_total_ = 0;
+    long forced_ = 0;
+};
+
+};
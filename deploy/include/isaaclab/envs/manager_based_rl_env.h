@@ -10,6 +10,7 @@
 #include "isaaclab/envs/mdp/commands/motion_command.h"
 #include "isaaclab/assets/articulation/articulation.h"
 #include "isaaclab/algorithms/algorithms.h"
+#include "isaaclab/envs/adaptive_inference.h"
 #include <iostream>
 #include <map>
 #include <string>
@@ -60,6 +61,7 @@ public:
         if (cfg["actions"])
         {
             action_manager = std::make_unique<ActionManager>(cfg["actions"], this);
+            action_manager->configure_chunking(cfg["action_chunk"], step_dt);
         }
         if (cfg["observations"])
         {
@@ -77,11 +79,30 @@ public:
         }
         if (action_manager) action_manager->reset();
         if (observation_manager) observation_manager->reset();
+        if (alg) alg->reset();
+        if (adaptive_inference) adaptive_inference->reset();
     }
 
+    /**
+     * Run the policy once on the current observations and check its action output against action_chunk, so a
+     * mismatching deploy.yaml fails while the state loads instead of on the policy thread. Call after setting
+     * alg; the observation history and the policy state are reset again on enter.
+     */
+    void check_action_output()
+    {
+        if (!observation_manager || !action_manager || !alg || !action_manager->chunked()) return;
+        std::map<std::string, std::vector<float>> results;
+        alg->forward_into(observation_manager->compute(), results);
+        auto it = results.find("actions");
+        if (it == results.end()) it = results.begin();
+        action_manager->check_chunk_output(it == results.end() ? 0 : it->second.size());
+    }
+
+    // One inference; with action chunking it covers action_manager->chunk_execute() policy steps.
     void step()
     {
-        episode_length += 1;
+        const auto obs_time = std::chrono::steady_clock::now();
+        episode_length += action_manager ? action_manager->chunk_execute() : 1;
         robot->update();
         if(robot->data.motion_loader) {
             robot->data.motion_loader->update(episode_length * step_dt);
@@ -90,18 +111,24 @@ public:
         {
             throw std::runtime_error("ManagerBasedRLEnv::step requires observation_manager, action_manager and alg");
         }
-        auto obs = observation_manager->compute();
-        
-        last_inference_results = alg->forward(obs);
-        
-        std::vector<float> action;
-        if (last_inference_results.count("actions")) {
-            action = last_inference_results["actions"];
-        } else if (!last_inference_results.empty()) {
-            action = last_inference_results.begin()->second;
+        const auto& obs = observation_manager->compute();
+        if (adaptive_inference && !adaptive_inference->should_infer(*observation_manager)) {
+            return; // quasi-static: hold the last action
         }
+
+        alg->forward_into(obs, last_inference_results);
         
-        action_manager->process_action(action);
+        auto it = last_inference_results.find("actions");
+        if (it == last_inference_results.end()) {
+            it = last_inference_results.begin();
+        }
+        if (it != last_inference_results.end() && action_manager->chunked()) {
+            action_manager->process_chunk(it->second, obs_time);
+        } else if (it != last_inference_results.end()) {
+            action_manager->process_action(it->second);
+        } else {
+            action_manager->process_action({});
+        }
     }
 
     float step_dt;
@@ -112,6 +139,7 @@ public:
     std::unique_ptr<ActionManager> action_manager;
     std::shared_ptr<Articulation> robot;
     std::unique_ptr<Algorithms> alg;
+    std::unique_ptr<AdaptiveInference> adaptive_inference;
     long episode_length = 0;
     float global_phase = 0.0f;
     
@@ -34,10 +34,10 @@ public:
         }
     }
 
-    void process_actions(std::vector<float> actions)
+    void process_actions(const std::vector<float>& actions)
     {
         // TODO: modify action by joint_ids
-        _raw_actions = actions;
+        _raw_actions.assign(actions.begin(), actions.end());
         for(int i(0); i<_action_dim; ++i)
         {
             _processed_actions[i] = _raw_actions[i] * _scale[i] + _offset[i];
@@ -66,6 +66,11 @@ public:
         return _processed_actions;
     }
 
+    void append_processed_actions(std::vector<float>& out)
+    {
+        out.insert(out.end(), _processed_actions.begin(), _processed_actions.end());
+    }
+
     void reset()
     {
         _raw_actions.assign(_action_dim, 0.0f);
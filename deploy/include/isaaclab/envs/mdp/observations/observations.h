@@ -4,145 +4,172 @@
 #pragma once
 
 #include "isaaclab/envs/manager_based_rl_env.h"
+#include <array>
+#include <cmath>
 
 namespace isaaclab
 {
 namespace mdp
 {
 
-REGISTER_OBSERVATION(base_ang_vel)
+struct NoParams
 {
-    auto & asset = env->robot;
-    auto & data = asset->data.root_ang_vel_b;
-    return std::vector<float>(data.data(), data.data() + data.size());
+    static NoParams from(ManagerBasedRLEnv*, const YAML::Node&) { return {}; }
+};
+
+// asset_cfg.joint_ids of a joint term; empty selects every joint.
+struct JointIdsParams
+{
+    std::vector<int> joint_ids;
+
+    static JointIdsParams from(ManagerBasedRLEnv*, const YAML::Node& params)
+    {
+        JointIdsParams p;
+        const auto asset_cfg = params["asset_cfg"];
+        if(asset_cfg && asset_cfg["joint_ids"]) {
+            p.joint_ids = asset_cfg["joint_ids"].as<std::vector<int>>();
+        }
+        return p;
+    }
+};
+
+// Joystick-to-command gains from commands.base_velocity.ranges: [min, max] per axis.
+struct VelocityCommandsParams
+{
+    std::array<float, 3> pos_scale;
+    std::array<float, 3> neg_scale;
+
+    static VelocityCommandsParams from(ManagerBasedRLEnv* env, const YAML::Node&)
+    {
+        auto cfg = env->cfg["commands"]["base_velocity"]["ranges"];
+        VelocityCommandsParams p;
+        const char* keys[3] = {"lin_vel_x", "lin_vel_y", "ang_vel_z"};
+        for(int i = 0; i < 3; ++i) {
+            p.pos_scale[i] = cfg[keys[i]][1].as<float>();
+            p.neg_scale[i] = -cfg[keys[i]][0].as<float>();
+        }
+        return p;
+    }
+};
+
+struct GaitPhaseParams
+{
+    float period;
+
+    static GaitPhaseParams from(ManagerBasedRLEnv*, const YAML::Node& params)
+    {
+        return {params["period"].as<float>()};
+    }
+};
+
+REGISTER_OBSERVATION_PARAMS(base_ang_vel, NoParams)
+{
+    auto & data = env->robot->data.root_ang_vel_b;
+    obs.assign(data.data(), data.data() + data.size());
 }
 
-REGISTER_OBSERVATION(projected_gravity)
+REGISTER_OBSERVATION_PARAMS(projected_gravity, NoParams)
 {
-    auto & asset = env->robot;
-    auto & data = asset->data.projected_gravity_b;
-    return std::vector<float>(data.data(), data.data() + data.size());
+    auto & data = env->robot->data.projected_gravity_b;
+    obs.assign(data.data(), data.data() + data.size());
 }
 
-REGISTER_OBSERVATION(joint_pos)
+REGISTER_OBSERVATION_PARAMS(joint_pos, JointIdsParams)
 {
-    auto & asset = env->robot;
-    std::vector<float> data;
+    auto & joint_pos = env->robot->data.joint_pos;
+    const auto & ids = params.joint_ids;
 
-    if(params["asset_cfg"]["joint_ids"])
+    if(!ids.empty())
     {
-        auto joint_ids = params["asset_cfg"]["joint_ids"].as<std::vector<int>>();
-        data.resize(joint_ids.size());
-        for(size_t i = 0; i < joint_ids.size(); ++i)
-        {
-            data[i] = asset->data.joint_pos[joint_ids[i]];
+        obs.resize(ids.size());
+        for(size_t i = 0; i < ids.size(); ++i) {
+            obs[i] = joint_pos[ids[i]];
         }
     }
     else
     {
-        data.resize(asset->data.joint_pos.size());
-        for(size_t i = 0; i < asset->data.joint_pos.size(); ++i)
-        {
-            data[i] = asset->data.joint_pos[i];
-        }
+        obs.assign(joint_pos.data(), joint_pos.data() + joint_pos.size());
     }
-
-    return data;
 }
 
-REGISTER_OBSERVATION(joint_pos_rel)
+REGISTER_OBSERVATION_PARAMS(joint_pos_rel, JointIdsParams)
 {
-    auto & asset = env->robot;
-    std::vector<float> data;
+    auto & data = env->robot->data;
+    const auto & ids = params.joint_ids;
 
-    if(params["asset_cfg"]["joint_ids"])
+    if(!ids.empty())
     {
-        auto joint_ids = params["asset_cfg"]["joint_ids"].as<std::vector<int>>();
-        data.resize(joint_ids.size());
-        for(size_t i = 0; i < joint_ids.size(); ++i) {
-            data[i] = asset->data.joint_pos[joint_ids[i]] - asset->data.default_joint_pos[joint_ids[i]];
+        obs.resize(ids.size());
+        for(size_t i = 0; i < ids.size(); ++i) {
+            obs[i] = data.joint_pos[ids[i]] - data.default_joint_pos[ids[i]];
         }
     }
     else
     {
-        data.resize(asset->data.joint_pos.size());
-        for(size_t i = 0; i < asset->data.joint_pos.size(); ++i) {
-            data[i] = asset->data.joint_pos[i] - asset->data.default_joint_pos[i];
+        obs.resize(data.joint_pos.size());
+        for(Eigen::Index i = 0; i < data.joint_pos.size(); ++i) {
+            obs[i] = data.joint_pos[i] - data.default_joint_pos[i];
         }
     }
-
-    return data;
 }
 
-REGISTER_OBSERVATION(joint_vel_rel)
+REGISTER_OBSERVATION_PARAMS(joint_vel_rel, JointIdsParams)
 {
-    auto & asset = env->robot;
+    auto & joint_vel = env->robot->data.joint_vel;
+    const auto & ids = params.joint_ids;
 
-    if(params["asset_cfg"]["joint_ids"])
+    if(!ids.empty())
     {
-        auto joint_ids = params["asset_cfg"]["joint_ids"].as<std::vector<int>>();
-        std::vector<float> data(joint_ids.size());
-        for(size_t i = 0; i < joint_ids.size(); ++i) {
-            data[i] = asset->data.joint_vel[joint_ids[i]];
+        obs.resize(ids.size());
+        for(size_t i = 0; i < ids.size(); ++i) {
+            obs[i] = joint_vel[ids[i]];
         }
-        return data;
     }
-
-    auto & data = asset->data.joint_vel;
-    return std::vector<float>(data.data(), data.data() + data.size());
+    else
+    {
+        obs.assign(joint_vel.data(), joint_vel.data() + joint_vel.size());
+    }
 }
 
-REGISTER_OBSERVATION(last_action)
+REGISTER_OBSERVATION_PARAMS(last_action, NoParams)
 {
-    auto data = env->action_manager->action();
-    return std::vector<float>(data.data(), data.data() + data.size());
-};
+    env->action_manager->action_into(obs);
+}
 
-REGISTER_OBSERVATION(velocity_commands)
+REGISTER_OBSERVATION_PARAMS(velocity_commands, VelocityCommandsParams)
 {
-    std::vector<float> obs(3);
+    obs.resize(3);
 
     // Check if fixed command mode is active
     if (env->fixed_command_enabled && env->fixed_command_active) {
         obs[0] = env->fixed_lin_vel_x;
         obs[1] = env->fixed_lin_vel_y;
         obs[2] = env->fixed_ang_vel_z;
-        return obs;
+        return;
     }
 
     auto & joystick = env->robot->data.joystick;
-    auto cfg = env->cfg["commands"]["base_velocity"]["ranges"];
-
     obs[0] = joystick->ly();
     obs[1] = -joystick->lx();
     obs[2] = -joystick->rx();
 
-    auto scale_func = [&cfg](std::vector<float>& obs, int idx, const std::string& key) {
-        if (obs[idx] > 0) {
-            obs[idx] *= cfg[key][1].as<float>();
-        } else {
-            obs[idx] *= -cfg[key][0].as<float>();
-        }
-    };
-    scale_func(obs, 0, "lin_vel_x");
-    scale_func(obs, 1, "lin_vel_y");
-    scale_func(obs, 2, "ang_vel_z");
-
-    return obs;
+    for(int i = 0; i < 3; ++i) {
+        obs[i] *= obs[i] > 0 ? params.pos_scale[i] : params.neg_scale[i];
+    }
 }
 
-REGISTER_OBSERVATION(gait_phase)
+REGISTER_OBSERVATION_PARAMS(gait_phase, GaitPhaseParams)
 {
-    float period = params["period"].as<float>();
-    float delta_phase = env->step_dt * (1.0f / period);
+    // One call per inference, which covers chunk_execute() policy steps with action chunking
+    const int steps = env->action_manager ? env->action_manager->chunk_execute() : 1;
+    float delta_phase = env->step_dt * steps * (1.0f / params.period);
 
     env->global_phase += delta_phase;
     env->global_phase = std::fmod(env->global_phase, 1.0f);
 
-    std::vector<float> obs(2);
+    obs.resize(2);
     obs[0] = std::sin(env->global_phase * 2 * M_PI);
     obs[1] = std::cos(env->global_phase * 2 * M_PI);
-    return obs;
 }
 
 }
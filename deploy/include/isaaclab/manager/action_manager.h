@@ -5,6 +5,10 @@
 
 #include "isaaclab/envs/manager_based_rl_env.h"
 #include "isaaclab/manager/manager_term_cfg.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cmath>
+#include <mutex>
 #include <numeric>
 
 namespace isaaclab
@@ -18,9 +22,16 @@ public:
     virtual int action_dim() = 0;
     virtual std::vector<float> raw_actions() = 0;
     virtual std::vector<float> processed_actions() = 0;
-    virtual void process_actions(std::vector<float> actions) = 0;
+    virtual void process_actions(const std::vector<float>& actions) = 0;
     virtual void reset(){};
 
+    // Append processed_actions() to `out`; override to skip the temporary.
+    virtual void append_processed_actions(std::vector<float>& out)
+    {
+        const auto actions = processed_actions();
+        out.insert(out.end(), actions.begin(), actions.end());
+    }
+
 protected:
     YAML::Node cfg;
     ManagerBasedRLEnv* env;
@@ -40,53 +51,153 @@ inline std::map<std::string, std::function<std::unique_ptr<ActionTerm>(YAML::Nod
         } \
     } name##_registrar_instance;
 
+/**
+ * Action chunking (deploy.yaml):
+ *   action_chunk:
+ *     size: 8          # the policy outputs `size` future actions, one per step_dt, concatenated
+ *     execute: 4       # run inference every `execute` steps (default `size`)
+ *     ensemble: 0.01   # optional temporal ensembling over overlapping chunks, weight exp(-ensemble * i), i = 0 oldest
+ *
+ * Read by configure_chunking(). The policy thread hands each chunk to process_chunk() with the time its observation was taken; the control
+ * loop calls apply_chunk() every tick, which picks the chunk entry for the elapsed time and processes it.
+ */
 class ActionManager
 {
 public:
+    using clock = std::chrono::steady_clock;
+
     ActionManager(YAML::Node cfg, ManagerBasedRLEnv* env)
     : cfg(cfg), env(env)
     {
         _prepare_terms();
         _action.resize(total_action_dim(), 0.0f);
+        for(auto & term : _terms) _term_actions.emplace_back(term->action_dim(), 0.0f);
     }
 
     void reset()
     {
+        std::lock_guard<std::mutex> lock(_mtx);
         _action.assign(total_action_dim(), 0.0f);
         for(auto & term : _terms)
         {
             term->reset();
         }
+        _chunk_count = 0;
     }
 
     std::vector<float> action()
     {
+        std::lock_guard<std::mutex> lock(_mtx);
         return _action;
     }
 
+    // action() into a caller-owned buffer, no allocation once it has the size.
+    void action_into(std::vector<float>& out)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        out.assign(_action.begin(), _action.end());
+    }
+
     std::vector<float> processed_actions()
     {
         std::vector<float> actions;
-        for(auto & term : _terms)
-        {
-            auto term_action = term->processed_actions();
-            actions.insert(actions.end(), term_action.begin(), term_action.end());
-        }
+        processed_actions_into(actions);
         return actions;
     }
 
-    void process_action(std::vector<float> action)
+    // processed_actions() into a caller-owned buffer, for the control loop.
+    void processed_actions_into(std::vector<float>& out)
     {
-        _action = action;
-        int idx = 0;
+        std::lock_guard<std::mutex> lock(_mtx);
+        out.clear();
         for(auto & term : _terms)
         {
-            auto term_action = std::vector<float>(action.begin() + idx, action.begin() + idx + term->action_dim());
-            term->process_actions(term_action);
-            idx += term->action_dim();
+            term->append_processed_actions(out);
         }
     }
 
+    void process_action(const std::vector<float>& action)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _process_action(action);
+    }
+
+    void configure_chunking(const YAML::Node& chunk_cfg, float step_dt)
+    {
+        if (!chunk_cfg) return;
+        _chunk_size = chunk_cfg["size"].as<int>();
+        _chunk_execute = chunk_cfg["execute"] ? chunk_cfg["execute"].as<int>() : _chunk_size;
+        _ensemble = chunk_cfg["ensemble"] ? chunk_cfg["ensemble"].as<float>() : -1.0f;
+        _step_dt = step_dt;
+        if (_chunk_size < 1 || _chunk_execute < 1 || _chunk_execute > _chunk_size) {
+            throw std::runtime_error("ActionManager: action_chunk needs 1 <= execute <= size.");
+        }
+        // Chunks still covering the present: the newest plus those it overlaps
+        _chunks.resize(_ensemble < 0.0f ? 1 : (_chunk_size + _chunk_execute - 1) / _chunk_execute);
+        for (auto& chunk : _chunks) chunk.data.reserve(total_action_dim() * _chunk_size);
+        _blended.resize(total_action_dim());
+        spdlog::info("ActionManager: action chunks of {} steps, inference every {} steps{}", _chunk_size, _chunk_execute,
+            _ensemble < 0.0f ? std::string() : ", temporal ensembling over " + std::to_string(_chunks.size()) + " chunks");
+    }
+
+    bool chunked() const { return _chunk_size > 1; }
+
+    // Policy steps covered by one inference.
+    int chunk_execute() const { return chunked() ? _chunk_execute : 1; }
+
+    // Throws if a policy output of `size` values does not hold `action_chunk.size` actions.
+    void check_chunk_output(size_t size) const
+    {
+        const size_t expected = _blended.size() * _chunk_size;
+        if (size != expected) {
+            throw std::runtime_error("ActionManager: action_chunk of size " + std::to_string(_chunk_size) + " expects "
+                + std::to_string(expected) + " actions, the policy returned " + std::to_string(size) + ".");
+        }
+    }
+
+    // Store a policy output of `chunk_size` actions whose first entry applies at `start`.
+    void process_chunk(const std::vector<float>& chunk, clock::time_point start)
+    {
+        check_chunk_output(chunk.size());
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto& slot = _chunks[_chunk_count % _chunks.size()];
+        slot.start = start;
+        slot.data.assign(chunk.begin(), chunk.end());
+        ++_chunk_count;
+    }
+
+    // Process the chunk entry due at `now`; with ensembling, a weighted mean over the chunks that cover `now`.
+    void apply_chunk(clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (_chunk_count == 0) return;
+        const size_t dim = _blended.size();
+        const size_t stored = std::min(_chunk_count, _chunks.size());
+        const auto& newest = _chunks[(_chunk_count - 1) % _chunks.size()];
+
+        if (_ensemble < 0.0f) {
+            const int j = std::min(_chunk_index(newest, now), _chunk_size - 1); // hold the last entry if inference is late
+            _blended.assign(newest.data.begin() + j * dim, newest.data.begin() + (j + 1) * dim);
+        } else {
+            std::fill(_blended.begin(), _blended.end(), 0.0f);
+            float total = 0.0f;
+            int age = 0;
+            for (size_t k = _chunk_count - stored; k < _chunk_count; ++k) {
+                const auto& chunk = _chunks[k % _chunks.size()];
+                int j = _chunk_index(chunk, now);
+                if (j >= _chunk_size) {
+                    if (&chunk != &newest) continue;
+                    j = _chunk_size - 1;
+                }
+                const float w = std::exp(-_ensemble * age++);
+                for (size_t i = 0; i < dim; ++i) _blended[i] += w * chunk.data[j * dim + i];
+                total += w;
+            }
+            for (auto& v : _blended) v /= total;
+        }
+        _process_action(_blended);
+    }
+
     int total_action_dim()
     {
         auto dims = action_dim();
@@ -108,6 +219,25 @@ public:
     ManagerBasedRLEnv* env;
 
 private:
+    struct Chunk
+    {
+        clock::time_point start;
+        std::vector<float> data;
+    };
+
+    void _process_action(const std::vector<float>& action)
+    {
+        _action.assign(action.begin(), action.end());
+        int idx = 0;
+        for(size_t t = 0; t < _terms.size(); ++t)
+        {
+            auto & term_action = _term_actions[t];
+            term_action.assign(action.begin() + idx, action.begin() + idx + term_action.size());
+            _terms[t]->process_actions(term_action);
+            idx += term_action.size();
+        }
+    }
+
     void _prepare_terms()
     {
         for(auto it = this->cfg.begin(); it != this->cfg.end(); ++it)
@@ -123,8 +253,24 @@ private:
         }
     }
 
+    int _chunk_index(const Chunk& chunk, clock::time_point now) const
+    {
+        const double elapsed = std::chrono::duration<double>(now - chunk.start).count();
+        return std::max(0, static_cast<int>(elapsed / _step_dt));
+    }
+
     std::vector<float> _action;
     std::vector<std::unique_ptr<ActionTerm>> _terms;
+    std::vector<std::vector<float>> _term_actions; // per-term slice of the action, reused
+    std::mutex _mtx;
+
+    int _chunk_size = 1;
+    int _chunk_execute = 1;
+    float _ensemble = -1.0f;
+    float _step_dt = 0.02f;
+    std::vector<Chunk> _chunks;
+    size_t _chunk_count = 0;
+    std::vector<float> _blended;
 };
 
 };
\ No newline at end of file
@@ -3,10 +3,13 @@
 
 #pragma once
 
-#include <deque>
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <functional>
+#include <limits>
 #include <numeric>
+#include <string>
 
 namespace isaaclab
 {
@@ -15,60 +18,114 @@ class ManagerBasedRLEnv;
 
 using ObsFunc = std::function<std::vector<float>(ManagerBasedRLEnv*, YAML::Node)>;
 
+// Observation term with its params already parsed: writes the current value into `obs`.
+using BoundObsFunc = std::function<void(ManagerBasedRLEnv*, std::vector<float>& obs)>;
+
+// Read-only run of contiguous floats inside a term's history buffer.
+struct FrameView
+{
+    const float* ptr = nullptr;
+    std::size_t n = 0;
+
+    const float* begin() const { return ptr; }
+    const float* end() const { return ptr + n; }
+    std::size_t size() const { return n; }
+    float operator[](std::size_t i) const { return ptr[i]; }
+};
+
 struct ObservationTermCfg
 {
+    std::string name;
     YAML::Node params;
-    ObsFunc func;
+    std::size_t source = 0; // the manager's shared evaluation of this (term, params)
     std::vector<float> clip;
     std::vector<float> scale;
     int history_length = 1;
     bool scale_first = false;
 
-    void reset(std::vector<float> obs)
+    // (Re)size the history for frames like `obs` and fill every frame with it.
+    void reset(const std::vector<float>& obs)
     {
-        for(int i(0); i < history_length; ++i) add(obs);
+        dim_ = obs.size();
+        buff_.assign(history_length * dim_, 0.0f);
+        head_ = 0;
+        _fuse_clip_scale();
+        _write(obs, buff_.data());
+        for(int i(1); i < history_length; ++i) {
+            std::copy(buff_.begin(), buff_.begin() + dim_, buff_.begin() + i * dim_);
+        }
     }
 
-    void add(std::vector<float> obs)
+    // Overwrite the oldest frame with the clipped / scaled `obs`.
+    void add(const std::vector<float>& obs)
     {
-        for(int j = 0; j < obs.size(); ++j)
-        {
-            if(scale_first) {
-                if(!scale.empty()) obs[j] *= scale[j];
-                if (!clip.empty()) {
-                    obs[j] = std::clamp(obs[j], clip[0], clip[1]);
-                }
-            } else {
-                if (!clip.empty()) {
-                    obs[j] = std::clamp(obs[j], clip[0], clip[1]);
-                }
-                if(!scale.empty()) obs[j] *= scale[j];
-            }
+        if (obs.size() != dim_) {
+            reset(obs);
+            return;
         }
-        buff_.push_back(obs);
+        _write(obs, buff_.data() + head_ * dim_);
+        head_ = (head_ + 1) % history_length;
+    }
+
+    // Frame `n`, oldest first
+    FrameView get(int n) const { return {buff_.data() + ((head_ + n) % history_length) * dim_, dim_}; }
 
-        if (buff_.size() > history_length) buff_.pop_front();
+    // Frame `n`, newest first
+    FrameView latest(int n = 0) const { return get(history_length - 1 - n); }
+
+    // The whole history oldest first, as at most two contiguous runs (the ring wraps at the write position).
+    std::array<FrameView, 2> spans() const
+    {
+        const std::size_t split = head_ * dim_;
+        return {FrameView{buff_.data() + split, buff_.size() - split}, FrameView{buff_.data(), split}};
     }
 
-    // Get a single frame by index
-    const std::vector<float> & get(int n) const { return buff_[n]; }
+    // Append all frames, oldest first
+    void append_to(std::vector<float>& out) const
+    {
+        for (const auto& span : spans()) out.insert(out.end(), span.begin(), span.end());
+    }
 
     // Get all frames concatenated (oldest first)
     const std::vector<float> get() const
     {
         std::vector<float> concatenated;
-        for (const auto& entry : buff_) {
-            concatenated.insert(concatenated.end(), entry.begin(), entry.end());
-        }
+        concatenated.reserve(buff_.size());
+        append_to(concatenated);
         return concatenated;
     }
 
-    const std::size_t size() const { return std::accumulate(buff_.begin(), buff_.end(), 0,
-        [](std::size_t sum, const auto& v) { return sum + v.size(); }); }
+    std::size_t dim() const { return dim_; }
+    const std::size_t size() const { return buff_.size(); }
 
 private:
-    // Complete circular buffer with most recent entry at the end and oldest entry at the beginning.
-    std::deque<std::vector<float>> buff_;
+    // Per-element clip bounds and scale, so that _write is one branch-free loop.
+    void _fuse_clip_scale()
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        lo_.assign(dim_, clip.empty() ? -inf : clip[0]);
+        hi_.assign(dim_, clip.empty() ? inf : clip[1]);
+        scale_.assign(dim_, 1.0f);
+        for(std::size_t j = 0; j < std::min(dim_, scale.size()); ++j) scale_[j] = scale[j];
+    }
+
+    void _write(const std::vector<float>& obs, float* dst) const
+    {
+        const float* lo = lo_.data();
+        const float* hi = hi_.data();
+        const float* s = scale_.data();
+        if(scale_first) {
+            for(std::size_t j = 0; j < dim_; ++j) dst[j] = std::min(std::max(obs[j] * s[j], lo[j]), hi[j]);
+        } else {
+            for(std::size_t j = 0; j < dim_; ++j) dst[j] = std::min(std::max(obs[j], lo[j]), hi[j]) * s[j];
+        }
+    }
+
+    // Fixed-capacity ring of history_length frames of dim_ floats; frame head_ is the oldest.
+    std::vector<float> buff_;
+    std::size_t dim_ = 0;
+    std::size_t head_ = 0;
+    std::vector<float> lo_, hi_, scale_;
 };
 
 };
\ No newline at end of file
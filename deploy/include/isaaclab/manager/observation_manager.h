@@ -5,6 +5,7 @@
 
 #include <eigen3/Eigen/Dense>
 #include <yaml-cpp/yaml.h>
+#include <memory>
 #include <unordered_set>
 #include "isaaclab/manager/manager_term_cfg.h"
 #include <iostream>
@@ -26,6 +27,38 @@ inline ObsMap& observations_map() {
     } name##_registrar_instance; \
     inline std::vector<float> name(ManagerBasedRLEnv* env, YAML::Node params)
 
+// Parses a term's params once, when the ObservationManager is built, and returns the per-step call.
+using ObsBinder = std::function<BoundObsFunc(ManagerBasedRLEnv*, const YAML::Node&)>;
+using ObsBinderMap = std::map<std::string, ObsBinder>;
+
+inline ObsBinderMap& observation_binders() {
+    static ObsBinderMap instance;
+    return instance;
+}
+
+template <typename Params>
+ObsBinder bind_observation(void (*fn)(ManagerBasedRLEnv*, const Params&, std::vector<float>&))
+{
+    return [fn](ManagerBasedRLEnv* env, const YAML::Node& params) -> BoundObsFunc {
+        auto bound = std::make_shared<const Params>(Params::from(env, params));
+        return [fn, bound](ManagerBasedRLEnv* env, std::vector<float>& obs) { fn(env, *bound, obs); };
+    };
+}
+
+/**
+ * Observation term with typed params: `Params::from(env, params)` runs once at construction and the
+ * function only gets the parsed struct and the term's reused output buffer (resize it to the term's size).
+ *
+ *   struct GaitPhaseParams { float period; static GaitPhaseParams from(ManagerBasedRLEnv*, const YAML::Node&); };
+ *   REGISTER_OBSERVATION_PARAMS(gait_phase, GaitPhaseParams) { obs.resize(2); ... }
+ */
+#define REGISTER_OBSERVATION_PARAMS(name, Params) \
+    inline void name(ManagerBasedRLEnv* env, const Params& params, std::vector<float>& obs); \
+    inline struct name##_registrar { \
+        name##_registrar() { observation_binders()[#name] = bind_observation<Params>(name); } \
+    } name##_registrar_instance; \
+    inline void name(ManagerBasedRLEnv* env, const Params& params, std::vector<float>& obs)
+
 
 class ObservationManager
 {
@@ -38,55 +71,47 @@ public:
 
     void reset()
     {
+        _evaluate_sources();
         for(auto & group : group_obs_term_cfgs_)
         {
             for(auto & term : group.second)
             {
-                term.reset(term.func(this->env, term.params));
+                term.reset(sources_[term.source].value);
             }
         }
     }
 
-    std::unordered_map<std::string, std::vector<float>> compute()
+    // Observations of every group. The returned buffers are reused by the next call.
+    const std::unordered_map<std::string, std::vector<float>>& compute()
     {
-        std::unordered_map<std::string, std::vector<float>> obs_map;
+        _evaluate_sources();
         for(const auto & group : group_obs_term_cfgs_)
         {
-            const auto group_obs = compute_group(group.first);
-            obs_map[group.first] = group_obs;
+            _fill_group(group.first);
         }
-        return obs_map;
+        return group_obs_;
     }
 
-    const std::vector<float> compute_group(const std::string& group_name)
+    const std::vector<float>& compute_group(const std::string& group_name)
     {
-        std::vector<float> obs;
-        auto& group_terms = group_obs_term_cfgs_.at(group_name);
-
-        for(auto & term : group_terms) {
-            term.add(term.func(this->env, term.params));
+        for(const auto & term : group_obs_term_cfgs_.at(group_name)) {
+            auto & source = sources_[term.source];
+            source.func(this->env, source.value);
         }
+        return _fill_group(group_name);
+    }
 
-        if(use_gym_history)
-        {
-            for(int h = 0; h < group_terms[0].history_length; ++h)
-            {
-                for(auto & term : group_terms)
-                {
-                    auto term_obs_scaled = term.get(h);
-                    obs.insert(obs.end(), term_obs_scaled.begin(), term_obs_scaled.end());
-                }
-            }            
-        }
-        else
+    // Call fn(term name, newest scaled frame) for every term of every group, in a fixed order.
+    template <typename Fn>
+    void for_each_latest(Fn fn) const
+    {
+        for(const auto & group : group_obs_term_cfgs_)
         {
-            for(const auto & term : group_terms)
+            for(const auto & term : group.second)
             {
-                auto obs_ = term.get();
-                obs.insert(obs.end(), obs_.begin(), obs_.end());
+                fn(term.name, term.latest());
             }
         }
-        return obs;
     }
 
 protected:
@@ -102,24 +127,28 @@ protected:
         bool only_one_input = false;
         for(auto it = this->cfg.begin(); it != this->cfg.end(); ++it) {
             std::string key = it->first.as<std::string>();
-            if(key == "use_gym_history" || key == "scale_first") continue;
+            if(_is_special_key(key)) continue;
             only_one_input = it->second["params"].IsDefined();
             break;
         }
 
         if(only_one_input) {
-            group_obs_term_cfgs_["obs"] = _prepare_group_terms(this->cfg); // default group name
+            group_obs_term_cfgs_["obs"] = _prepare_group_terms(this->cfg, "obs"); // default group name
         } else {
             for(auto group = this->cfg.begin(); group != this->cfg.end(); ++group)
             {
                 auto group_name = group->first.as<std::string>();
-                if(group_name == "use_gym_history" || group_name == "scale_first") continue;
-                group_obs_term_cfgs_[group_name] = _prepare_group_terms(group->second);
+                if(_is_special_key(group_name)) continue;
+                group_obs_term_cfgs_[group_name] = _prepare_group_terms(group->second, group_name);
             }
         }
+        for(const auto & group : group_obs_term_cfgs_)
+        {
+            _compile_plan(group.first);
+        }
     }
 
-    std::vector<ObservationTermCfg> _prepare_group_terms(const YAML::Node & group_cfg)
+    std::vector<ObservationTermCfg> _prepare_group_terms(const YAML::Node & group_cfg, const std::string& group_name)
     {
         std::vector<ObservationTermCfg> terms;
         bool scale_first = false; // isaaclab default: clip first
@@ -134,35 +163,145 @@ protected:
                 use_gym_history = it->second.as<bool>();
                 continue;
             }
+            if(key == "history_order") {
+                group_plans_[group_name].history_order = it->second.as<std::string>();
+                continue;
+            }
 
             /*** observation terms ***/
             const auto term_yaml_cfg = it->second;
             ObservationTermCfg term_cfg;
+            term_cfg.name = it->first.as<std::string>();
             term_cfg.params = term_yaml_cfg["params"];
             term_cfg.scale_first = scale_first;
             term_cfg.history_length = term_yaml_cfg["history_length"].as<int>(1);
 
-            auto term_name = it->first.as<std::string>();
-            if(observations_map()[term_name] == nullptr) {
-                throw std::runtime_error("Observation term '" + term_name + "' is not registered.");
-            }
-
             if(!term_yaml_cfg["scale"].IsNull()) {
                 term_cfg.scale = term_yaml_cfg["scale"].as<std::vector<float>>();
             }
             if(!term_yaml_cfg["clip"].IsNull()) {
                 term_cfg.clip = term_yaml_cfg["clip"].as<std::vector<float>>();
             }
-            term_cfg.func = observations_map()[term_name];   
-
-            auto obs = term_cfg.func(this->env, term_cfg.params);
-            term_cfg.reset(obs);
+            term_cfg.source = _source(term_cfg.name, term_cfg.params);
+            term_cfg.reset(sources_[term_cfg.source].value);
 
             terms.push_back(term_cfg);
         }
         return terms;
     }
 
+    /**
+     * Index of the shared evaluation of (term, params), created and evaluated on first use. Groups that
+     * list the same term with the same params read one raw value per step and only clip / scale / stack
+     * it separately, so stateful terms such as gait_phase also advance once per step.
+     */
+    std::size_t _source(const std::string& term_name, const YAML::Node& params)
+    {
+        const std::string key = term_name + "\n" + (params.IsDefined() ? YAML::Dump(params) : "");
+        auto it = source_index_.find(key);
+        if(it != source_index_.end()) return it->second;
+
+        auto & source = sources_.emplace_back();
+        source.func = _bind(term_name, params);
+        source.func(this->env, source.value);
+        return source_index_[key] = sources_.size() - 1;
+    }
+
+    void _evaluate_sources()
+    {
+        for(auto & source : sources_) {
+            source.func(this->env, source.value);
+        }
+    }
+
+    // Push the current raw values into the group's terms and lay the group out.
+    const std::vector<float>& _fill_group(const std::string& group_name)
+    {
+        auto& obs = group_obs_[group_name];
+        auto& group_terms = group_obs_term_cfgs_.at(group_name);
+        auto& plan = group_plans_.at(group_name);
+
+        for(auto & term : group_terms) {
+            term.add(sources_[term.source].value);
+        }
+        for(std::size_t t = 0; t < group_terms.size(); ++t) {
+            if(group_terms[t].dim() != plan.dims[t]) { // a term changed size: lay the group out again
+                _compile_plan(group_name);
+                break;
+            }
+        }
+
+        obs.resize(plan.size);
+        float* dst = obs.data();
+        for(const auto & copy : plan.copies)
+        {
+            const auto frame = group_terms[copy.term].get(copy.frame);
+            std::copy(frame.begin(), frame.end(), dst + copy.dst);
+        }
+        return obs;
+    }
+
+    // Typed terms parse their params here; plain ones get them on every call.
+    BoundObsFunc _bind(const std::string& term_name, const YAML::Node& params)
+    {
+        auto binder = observation_binders().find(term_name);
+        if(binder != observation_binders().end()) {
+            return binder->second(this->env, params);
+        }
+        auto func = observations_map().find(term_name);
+        if(func == observations_map().end() || func->second == nullptr) {
+            throw std::runtime_error("Observation term '" + term_name + "' is not registered.");
+        }
+        return [fn = func->second, params](ManagerBasedRLEnv* env, std::vector<float>& obs) { obs = fn(env, params); };
+    }
+
+    static bool _is_special_key(const std::string& key)
+    {
+        return key == "use_gym_history" || key == "scale_first" || key == "history_order";
+    }
+
+    /**
+     * Lay out a group once: where every history frame of every term lands in the group's buffer.
+     * history_order (per group, default from use_gym_history):
+     *   oldest_first  term by term, each term's frames oldest to newest (isaaclab)
+     *   newest_first  term by term, each term's frames newest to oldest (BFM)
+     *   interleaved   frame by frame, all terms of the oldest frame first (gym); needs equal history lengths
+     */
+    void _compile_plan(const std::string& group_name)
+    {
+        const auto& terms = group_obs_term_cfgs_.at(group_name);
+        auto& plan = group_plans_[group_name];
+        const std::string order = !plan.history_order.empty() ? plan.history_order
+            : use_gym_history ? "interleaved" : "oldest_first";
+
+        plan.copies.clear();
+        plan.dims.clear();
+        std::size_t dst = 0;
+        auto emit = [&](std::size_t t, int frame) {
+            plan.copies.push_back({t, frame, dst});
+            dst += terms[t].dim();
+        };
+        if(order == "interleaved") {
+            for(const auto & term : terms) {
+                if(term.history_length != terms[0].history_length) {
+                    throw std::runtime_error("Observation group '" + group_name + "': interleaved history needs equal history_length.");
+                }
+            }
+            for(int h = 0; !terms.empty() && h < terms[0].history_length; ++h) {
+                for(std::size_t t = 0; t < terms.size(); ++t) emit(t, h);
+            }
+        } else if(order == "oldest_first" || order == "newest_first") {
+            for(std::size_t t = 0; t < terms.size(); ++t) {
+                const int n = terms[t].history_length;
+                for(int k = 0; k < n; ++k) emit(t, order == "newest_first" ? n - 1 - k : k);
+            }
+        } else {
+            throw std::runtime_error("Observation group '" + group_name + "': history_order must be oldest_first, newest_first or interleaved.");
+        }
+        for(const auto & term : terms) plan.dims.push_back(term.dim());
+        plan.size = dst;
+    }
+
     const YAML::Node cfg;
     ManagerBasedRLEnv* env;
 
@@ -170,7 +309,31 @@ protected:
     bool use_gym_history = false; // Manually set in the configuration file
 
 private:
+    struct GroupPlan
+    {
+        struct Copy
+        {
+            std::size_t term;
+            int frame;       // oldest first
+            std::size_t dst; // offset in the group buffer
+        };
+        std::string history_order; // empty: follow use_gym_history
+        std::vector<Copy> copies;
+        std::vector<std::size_t> dims;
+        std::size_t size = 0;
+    };
+
+    struct TermSource
+    {
+        BoundObsFunc func;
+        std::vector<float> value; // raw output of func, reused every step
+    };
+
+    std::vector<TermSource> sources_;
+    std::unordered_map<std::string, std::size_t> source_index_;
     std::unordered_map<std::string, std::vector<ObservationTermCfg>> group_obs_term_cfgs_;
+    std::unordered_map<std::string, GroupPlan> group_plans_;
+    std::unordered_map<std::string, std::vector<float>> group_obs_;
 };
 
 };
\ No newline at end of file
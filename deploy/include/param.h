@@ -15,6 +15,9 @@
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <memory>
 #include <iomanip>
+#include <string>
+#include <stdexcept>
+#include <vector>
 
 /* ---------- logger ---------- */
 namespace spdlog
@@ -130,6 +133,7 @@ inline po::variables_map helper(int argc, char** argv)
         ("version,v", "show version")
         ("log", "record log file")
         ("network,n", po::value<std::string>()->default_value(""), "dds network interface")
+        ("profile", po::value<std::vector<std::string>>()->composing(), "ORT profiling of a state's sessions: STATE[:STEPS] (default 500 steps)")
         ;
 
     po::variables_map vm;
@@ -157,6 +161,31 @@ inline po::variables_map helper(int argc, char** argv)
         std::filesystem::create_directories(proj_dir / "log");
         spdlog::create_logger(proj_dir.string() + "/log/log.txt");
     }
+    if(vm.count("profile"))
+    {
+        // Same as setting onnx_profile_steps in the state's config.yaml entry
+        for (const auto& arg : vm["profile"].as<std::vector<std::string>>())
+        {
+            const auto colon = arg.find(':');
+            const std::string state = arg.substr(0, colon);
+            int steps = 500;
+            if (colon != std::string::npos) {
+                try {
+                    size_t used = 0;
+                    steps = std::stoi(arg.substr(colon + 1), &used);
+                    if (used != arg.size() - colon - 1) throw std::invalid_argument(arg);
+                } catch (const std::exception&) {
+                    spdlog::warn("--profile: invalid step count in {}, expected <state>[:<steps>]", arg);
+                    continue;
+                }
+            }
+            if (!config["FSM"]["_"][state]) {
+                spdlog::warn("--profile: state {} is not enabled in config.yaml", state);
+                continue;
+            }
+            config["FSM"][state]["onnx_profile_steps"] = steps;
+        }
+    }
 
     return vm;
 }
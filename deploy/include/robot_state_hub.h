@@ -0,0 +1,145 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace unitree
+{
+
+// One decoded LowState message, in sdk motor order.
+struct alignas(64) RobotState
+{
+    static constexpr int kMaxMotors = 35;
+
+    uint64_t seq = 0;   // message count, 0 before the first one; unchanged while no new LowState arrives
+    uint32_t tick = 0;  // LowState tick of the message
+    double stamp = 0.0; // steady_clock seconds when the message was decoded; now - stamp is its age
+    int num_motors = 0;
+
+    std::array<float, 4> quat{1.0f, 0.0f, 0.0f, 0.0f}; // w, x, y, z
+    std::array<float, 3> gyro{};
+    std::array<float, 3> acc{};
+    std::array<float, 3> rpy{};
+
+    std::array<float, kMaxMotors> q{};
+    std::array<float, kMaxMotors> dq{};
+    std::array<float, kMaxMotors> tau_est{};
+    std::array<float, kMaxMotors> temperature{};
+
+    std::array<float, 4> foot_force{}; // go2 only
+};
+
+static_assert(std::is_trivially_copyable<RobotState>::value, "RobotState is copied with memcpy");
+
+/**
+ * Single place where the LowState message is decoded.
+ *
+ * The FSM thread calls update() once per control tick (FSMState::pre_run). A message whose tick differs from
+ * the last published one is copied out under the subscriber's mutex, so it is never half-written by the DDS
+ * callback, and published through a seqlock; repeated ticks are skipped, so each message is decoded once.
+ * Policy threads and the FSM read it with read(), which never blocks the writer and retries only if a
+ * publication overlapped the copy, so every reader sees one consistent message with its sequence number
+ * and timestamp. Nothing else should touch lowstate->msg_.
+ */
+template <typename LowStatePtr>
+class RobotStateHub
+{
+public:
+    explicit RobotStateHub(LowStatePtr lowstate)
+    : lowstate_(std::move(lowstate))
+    {
+    }
+
+    // Decode and publish the current message if its tick is new; false if it was already published. Single writer.
+    bool update()
+    {
+        RobotState next;
+        {
+            std::lock_guard<std::mutex> lock(lowstate_->mutex_);
+            if (published_ && lowstate_->msg_.tick() == last_tick_) return false;
+            _decode(lowstate_->msg_, next);
+        }
+        published_ = true;
+        last_tick_ = next.tick;
+        next.stamp = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        next.seq = seq / 2 + 1;
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&state_, &next, sizeof(RobotState));
+        seq_.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+    // Latest published state, never torn.
+    RobotState read() const
+    {
+        RobotState out;
+        uint64_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            std::memcpy(&out, &state_, sizeof(RobotState));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return out;
+    }
+
+    // Number of messages published so far.
+    uint64_t sequence() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    template <typename M, typename = void>
+    struct has_foot_force : std::false_type {};
+    template <typename M>
+    struct has_foot_force<M, std::void_t<decltype(std::declval<const M&>().foot_force())>> : std::true_type {};
+
+    static float _temperature(uint8_t t) { return t; }
+    template <typename T, std::size_t N>
+    static float _temperature(const std::array<T, N>& t) { return t[0]; } // hg: {winding, housing}
+
+    template <typename Msg>
+    static void _decode(const Msg& msg, RobotState& s)
+    {
+        s.tick = msg.tick();
+        const auto& imu = msg.imu_state();
+        for(int i(0); i < 4; ++i) s.quat[i] = imu.quaternion()[i];
+        for(int i(0); i < 3; ++i) {
+            s.gyro[i] = imu.gyroscope()[i];
+            s.acc[i] = imu.accelerometer()[i];
+            s.rpy[i] = imu.rpy()[i];
+        }
+
+        const auto& motors = msg.motor_state();
+        s.num_motors = std::min<int>(motors.size(), RobotState::kMaxMotors);
+        for(int i(0); i < s.num_motors; ++i) {
+            s.q[i] = motors[i].q();
+            s.dq[i] = motors[i].dq();
+            s.tau_est[i] = motors[i].tau_est();
+            s.temperature[i] = _temperature(motors[i].temperature());
+        }
+
+        if constexpr (has_foot_force<Msg>::value) {
+            for(int i(0); i < 4; ++i) s.foot_force[i] = msg.foot_force()[i];
+        }
+    }
+
+    LowStatePtr lowstate_;
+    bool published_ = false; // writer only
+    uint32_t last_tick_ = 0;
+    alignas(64) std::atomic<uint64_t> seq_{0}; // odd while a publication is in progress
+    RobotState state_;
+};
+
+}
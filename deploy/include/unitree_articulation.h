@@ -4,6 +4,8 @@
 #pragma once
 
 #include "isaaclab/assets/articulation/articulation.h"
+#include "robot_state_hub.h"
+#include <memory>
 
 namespace unitree
 {
@@ -12,34 +14,32 @@ template <typename LowStatePtr>
 class BaseArticulation : public isaaclab::Articulation
 {
 public:
-    BaseArticulation(LowStatePtr lowstate_)
-    : lowstate(lowstate_)
+    BaseArticulation(LowStatePtr lowstate_, std::shared_ptr<RobotStateHub<LowStatePtr>> hub_)
+    : lowstate(lowstate_), hub(std::move(hub_))
     {
         data.joystick = &lowstate->joystick;
     }
 
     void update() override
     {
+        state = hub->read();
         // base_angular_velocity
         for(int i(0); i<3; i++) {
-            data.root_ang_vel_b[i] = lowstate->msg_.imu_state().gyroscope()[i];
+            data.root_ang_vel_b[i] = state.gyro[i];
         }
         // project_gravity_body
-        data.root_quat_w = Eigen::Quaternionf(
-            lowstate->msg_.imu_state().quaternion()[0],
-            lowstate->msg_.imu_state().quaternion()[1],
-            lowstate->msg_.imu_state().quaternion()[2],
-            lowstate->msg_.imu_state().quaternion()[3]
-        );
+        data.root_quat_w = Eigen::Quaternionf(state.quat[0], state.quat[1], state.quat[2], state.quat[3]);
         data.projected_gravity_b = data.root_quat_w.conjugate() * data.GRAVITY_VEC_W;
         // joint positions and velocities
         for(int i(0); i< data.joint_ids_map.size(); i++) {
-            data.joint_pos[i] = lowstate->msg_.motor_state()[data.joint_ids_map[i]].q();
-            data.joint_vel[i] = lowstate->msg_.motor_state()[data.joint_ids_map[i]].dq();
+            data.joint_pos[i] = state.q[data.joint_ids_map[i]];
+            data.joint_vel[i] = state.dq[data.joint_ids_map[i]];
         }
     }
 
     LowStatePtr lowstate;
+    std::shared_ptr<RobotStateHub<LowStatePtr>> hub;
+    RobotState state; // snapshot behind the current data
 };
 
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ class State_BFM : public FSMState
 public:
     State_BFM(int state_mode, std::string state_string);
 
+    void load();
     void enter();
     void run();
     void exit();
@@ -67,10 +68,9 @@ private:
 private:
     std::unique_ptr<isaaclab::ManagerBasedRLEnv> env_;
 
-    // ONNX runtime (BFM custom path; CUDA first, CPU fallback)
-    Ort::Env ort_env_{ORT_LOGGING_LEVEL_WARNING, "bfm_onnx"};
+    // ONNX runtime (BFM custom path; CUDA first, CPU fallback). Env is the shared isaaclab::InferenceRuntime.
     Ort::SessionOptions session_options_;
-    std::unique_ptr<Ort::Session> session_;
+    std::shared_ptr<Ort::Session> session_;
     Ort::AllocatorWithDefaultOptions allocator_;
     std::string onnx_input_name_;
     std::vector<std::string> output_names_str_;
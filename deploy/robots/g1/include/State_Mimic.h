@@ -11,6 +11,7 @@ class State_Mimic : public FSMState
 public:
     State_Mimic(int state_mode, std::string state_string);
 
+    void load();
     void enter();
     void run();
     void exit();
@@ -24,6 +25,7 @@ private:
 
     std::unique_ptr<isaaclab::ManagerBasedRLEnv> env_;
     std::shared_ptr<MotionLoader_> motion_;
+    std::vector<float> processed_action_; // run() buffer
 
     std::thread policy_thread_;
     std::atomic<bool> policy_thread_running_{false};
@@ -5,8 +5,11 @@
 
 #include "FSM/FSMState.h"
 #include "isaaclab/envs/manager_based_rl_env.h"
+#include "isaaclab/assets/articulation/kinematic_chain.h"
+#include "isaaclab/algorithms/inference_worker.h"
 #include "onnxruntime_cxx_api.h"
 #include <unitree/dds_wrapper/common/unitree_joystick.hpp>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <deque>
@@ -26,6 +29,7 @@ class State_OmniXtreme : public FSMState
 public:
     State_OmniXtreme(int state_mode, std::string state_string);
 
+    void load();
     void enter();
     void run();
     void exit();
@@ -53,10 +57,13 @@ private:
     void load_key_config(const YAML::Node& cfg);
     void initialize_limits(const YAML::Node& cfg);
     void calibrate_yaw_alignment();
+    void verify_analytic_fk(float tol);
     void warmup_models();
 
     std::vector<float> build_real_obs(const std::vector<float>& motion_command) const;
     std::vector<float> build_command_obs(const MotionTrajectory& traj, std::size_t frame_index);
+    Eigen::Quaternionf onnx_fk_anchor_quat(
+        std::array<float, 3>& joint_angles, std::array<float, 3>& base_pos, std::array<float, 4>& base_quat);
     std::vector<float> build_residual_obs(
         const std::vector<float>& real_obs,
         const std::vector<float>& command_obs,
@@ -67,7 +74,9 @@ private:
         const std::vector<float>& command_obs,
         const std::vector<float>& real_hist);
     std::vector<float> infer_residual_action(const std::vector<float>& residual_obs);
+    void set_residual_base_action(std::vector<float>& residual_obs, const std::vector<float>& base_action) const;
     std::vector<float> compute_q_target(const std::vector<float>& action) const;
+    void compute_torque_limits(std::vector<float>& q_low, std::vector<float>& q_high, std::vector<float>& tau_ff) const;
 
     void reset_tracking_state(bool keep_current_traj);
     void handle_gamepad_events();
@@ -81,11 +90,10 @@ private:
     YAML::Node deploy_cfg_;
     std::unique_ptr<isaaclab::ManagerBasedRLEnv> env_;
 
-    Ort::Env ort_env_{ORT_LOGGING_LEVEL_WARNING, "omnixtreme_onnx"};
     Ort::SessionOptions base_session_options_;
     Ort::SessionOptions residual_session_options_;
-    std::unique_ptr<Ort::Session> base_session_;
-    std::unique_ptr<Ort::Session> residual_session_;
+    std::shared_ptr<Ort::Session> base_session_;
+    std::shared_ptr<Ort::Session> residual_session_;
     Ort::AllocatorWithDefaultOptions allocator_;
 
     std::vector<std::string> base_input_names_str_;
@@ -100,9 +108,12 @@ private:
     std::vector<const char*> residual_output_names_;
     std::string residual_action_output_name_ = "actions";
 
-    std::unique_ptr<Ort::Session> fk_session_;
+    std::shared_ptr<Ort::Session> fk_session_;
     std::vector<std::string> fk_output_names_str_;
     std::vector<const char*> fk_output_names_;
+    std::unique_ptr<isaaclab::KinematicChain> fk_chain_; // analytic replacement for fk_session_
+
+    std::unique_ptr<isaaclab::InferenceWorker> inference_worker_; // async_inference: FK / base model off the loop thread
 
     std::thread policy_thread_;
     std::atomic<bool> policy_thread_running_{false};
@@ -2,6 +2,8 @@
 
 #include "unitree/dds_wrapper/robots/go2/go2.h"
 #include "unitree/dds_wrapper/robots/g1/g1.h"
+#include "robot_state_hub.h"
 
 using LowCmd_t = unitree::robot::g1::publisher::LowCmd;
 using LowState_t = unitree::robot::g1::subscription::LowState;
+using RobotStateHub_t = unitree::RobotStateHub<LowState_t::SharedPtr>;
@@ -8,6 +8,7 @@
 
 std::unique_ptr<LowCmd_t> FSMState::lowcmd = nullptr;
 std::shared_ptr<LowState_t> FSMState::lowstate = nullptr;
+std::shared_ptr<RobotStateHub_t> FSMState::state_hub = nullptr;
 std::shared_ptr<Keyboard> FSMState::keyboard = std::make_shared<Keyboard>();
 
 void init_fsm_state()
@@ -25,6 +26,8 @@ void init_fsm_state()
     spdlog::info("Waiting for connection to robot...");
     FSMState::lowstate->wait_for_connection();
     spdlog::info("Connected to robot.");
+    FSMState::state_hub = std::make_shared<RobotStateHub_t>(FSMState::lowstate);
+    FSMState::state_hub->update();
 }
 
 int main(int argc, char** argv)
@@ -46,6 +49,9 @@ int main(int argc, char** argv)
         exit(-1);
     }
     
+    // Shared ONNX Runtime env / thread pools, must be configured before any state loads a policy
+    isaaclab::InferenceRuntime::instance().configure(param::config["inference"]);
+
     // Initialize FSM from config
     auto fsm = std::make_unique<CtrlFSM>(param::config["FSM"]);
     fsm->start();
@@ -28,77 +28,6 @@ std::string infer_task_type_from_name(const std::string& state_name)
     return "goal";
 }
 
-enum class OnnxExecProvider
-{
-    TensorRT,
-    CUDA,
-    CPU
-};
-
-OnnxExecProvider append_best_provider(Ort::SessionOptions& options, int device_id, bool enable_tensorrt, bool enable_cuda)
-{
-    const OrtApi& api = Ort::GetApi();
-
-    char** providers = nullptr;
-    int provider_count = 0;
-    OrtStatus* status = api.GetAvailableProviders(&providers, &provider_count);
-    if (status != nullptr)
-    {
-        spdlog::warn("State_BFM: GetAvailableProviders failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-        return OnnxExecProvider::CPU;
-    }
-
-    bool has_tensorrt = false;
-    bool has_cuda = false;
-    for (int i = 0; i < provider_count; ++i)
-    {
-        const std::string provider_name = providers[i];
-        if (provider_name == "TensorrtExecutionProvider")
-        {
-            has_tensorrt = true;
-        }
-        else if (provider_name == "CUDAExecutionProvider")
-        {
-            has_cuda = true;
-        }
-    }
-
-    OrtStatus* release_status = api.ReleaseAvailableProviders(providers, provider_count);
-    if (release_status != nullptr)
-    {
-        api.ReleaseStatus(release_status);
-    }
-
-    if (enable_tensorrt && has_tensorrt)
-    {
-        OrtTensorRTProviderOptions trt_options{};
-        trt_options.device_id = device_id;
-        status = api.SessionOptionsAppendExecutionProvider_TensorRT(options, &trt_options);
-        if (status == nullptr)
-        {
-            return OnnxExecProvider::TensorRT;
-        }
-        spdlog::warn("State_BFM: append TensorRT provider failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-    }
-
-    if (enable_cuda && has_cuda)
-    {
-        OrtCUDAProviderOptions cuda_options{};
-        cuda_options.device_id = device_id;
-        status = api.SessionOptionsAppendExecutionProvider_CUDA(options, &cuda_options);
-        if (status == nullptr)
-        {
-            return OnnxExecProvider::CUDA;
-        }
-        spdlog::warn("State_BFM: append CUDA provider failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-    }
-
-    return OnnxExecProvider::CPU;
-}
-
 std::vector<float> clamp_vec(const std::vector<float>& x, const std::vector<float>& lo, const std::vector<float>& hi)
 {
     std::vector<float> y = x;
@@ -129,12 +58,15 @@ State_BFM::State_BFM(int state_mode, std::string state_string)
     {
         throw std::runtime_error("State_BFM: missing config for state " + state_string);
     }
+}
 
+void State_BFM::load()
+{
+    const auto& cfg = state_cfg_;
     load_policy_and_env(cfg);
     initialize_limits(cfg);
     load_task_context(cfg);
     load_key_config(cfg);
-
 }
 
 void State_BFM::load_policy_and_env(const YAML::Node& cfg)
@@ -152,25 +84,31 @@ void State_BFM::load_policy_and_env(const YAML::Node& cfg)
     const auto onnx_path = policy_dir / onnx_rel;
 
     auto deploy_cfg = YAML::LoadFile(deploy_path.string());
+    // BFM python stacks each history term newest -> oldest
+    if (deploy_cfg["observations"]["obs_hist"] && !deploy_cfg["observations"]["obs_hist"]["history_order"])
+    {
+        deploy_cfg["observations"]["obs_hist"]["history_order"] = "newest_first";
+    }
 
     env_ = std::make_unique<isaaclab::ManagerBasedRLEnv>(
         deploy_cfg,
-        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate)
+        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate, FSMState::state_hub)
     );
 
     action_scale_ = deploy_cfg["actions"]["JointPositionAction"]["scale"].as<std::vector<float>>();
     default_joint_pos_ = deploy_cfg["default_joint_pos"].as<std::vector<float>>();
     action_rescale_ = deploy_cfg["action_rescale"] ? deploy_cfg["action_rescale"].as<float>() : 5.0f;
 
-    const bool prefer_cuda = cfg["onnx_cuda"] ? cfg["onnx_cuda"].as<bool>() : true;
-    const bool prefer_tensorrt = cfg["onnx_tensorrt"] ? cfg["onnx_tensorrt"].as<bool>() : true;
-    const int cuda_device_id = cfg["onnx_cuda_device"] ? cfg["onnx_cuda_device"].as<int>() : 0;
+    isaaclab::SessionConfig onnx_defaults;
+    onnx_defaults.providers = {"TensorRT", "CUDA", "CPU"};
+    const auto onnx_cfg = isaaclab::SessionConfig::from(cfg, onnx_defaults, policy_dir);
 
-    session_options_.SetGraphOptimizationLevel(ORT_ENABLE_EXTENDED);
-    const OnnxExecProvider selected_provider =
-        append_best_provider(session_options_, cuda_device_id, prefer_tensorrt, prefer_cuda);
-
-    session_ = std::make_unique<Ort::Session>(ort_env_, onnx_path.string().c_str(), session_options_);
+    std::string selected_provider;
+    session_ = isaaclab::InferenceRuntime::instance().create_session(
+        onnx_path.string(), session_options_, "State_BFM", onnx_cfg, &selected_provider);
+    session_ = isaaclab::quantize_session(
+        std::move(session_), onnx_path.string(), "State_BFM",
+        isaaclab::QuantizationConfig::from(cfg["quantization"]), onnx_cfg, selected_provider);
 
     auto input_name = session_->GetInputNameAllocated(0, allocator_);
     onnx_input_name_ = input_name.get();
@@ -201,15 +139,7 @@ void State_BFM::load_policy_and_env(const YAML::Node& cfg)
     }
 
     spdlog::info("State_BFM: loaded ONNX model: {}", onnx_path.string());
-    if (selected_provider == OnnxExecProvider::TensorRT)
-    {
-        spdlog::info("State_BFM: execution provider: TensorRT");
-    }
-    else if (selected_provider == OnnxExecProvider::CUDA)
-    {
-        spdlog::info("State_BFM: execution provider: CUDA");
-    }
-    else
+    if (selected_provider == "CPU" && (onnx_cfg.has_provider("TensorRT") || onnx_cfg.has_provider("CUDA")))
     {
         spdlog::warn("State_BFM: TensorRT/CUDA provider not available, fallback to CPU");
     }
@@ -736,7 +666,7 @@ void State_BFM::handle_gamepad_events()
 
 std::vector<float> State_BFM::build_policy_obs() const
 {
-    auto obs_map = env_->observation_manager->compute();
+    const auto& obs_map = env_->observation_manager->compute();
     auto it_base = obs_map.find("obs_base");
     if (it_base == obs_map.end())
     {
@@ -748,31 +678,10 @@ std::vector<float> State_BFM::build_policy_obs() const
         throw std::runtime_error("State_BFM: observation group 'obs_hist' not found");
     }
 
-    std::vector<float> obs = it_base->second;
-    auto hist = it_hist->second;
-
-    // ObservationManager history is oldest->newest for each term.
-    // Convert to newest->oldest to match BFM python history layout.
-    const std::size_t dof = env_->robot->data.joint_pos.size();
-    const std::size_t hist_len = 4;
-    const std::array<std::size_t, 5> dims = {dof, 3, dof, dof, 3};
-    std::size_t cursor = 0;
-    for (auto dim : dims)
-    {
-        const std::size_t block_size = dim * hist_len;
-        if (cursor + block_size > hist.size())
-        {
-            throw std::runtime_error("State_BFM: obs_hist size mismatch");
-        }
-        for (std::size_t h = 0; h < hist_len; ++h)
-        {
-            const std::size_t src_h = hist_len - 1 - h;
-            const std::size_t src = cursor + src_h * dim;
-            obs.insert(obs.end(), hist.begin() + src, hist.begin() + src + dim);
-        }
-        cursor += block_size;
-    }
-
+    std::vector<float> obs;
+    obs.reserve(it_base->second.size() + it_hist->second.size());
+    obs.insert(obs.end(), it_base->second.begin(), it_base->second.end());
+    obs.insert(obs.end(), it_hist->second.begin(), it_hist->second.end());
     return obs;
 }
 
@@ -888,6 +797,7 @@ std::vector<float> State_BFM::infer_action(const std::vector<float>& input)
         output_names_.data(),
         output_names_.size()
     );
+    isaaclab::InferenceRuntime::instance().profile_step(*session_);
 
     std::size_t action_out_idx = 0;
     for (std::size_t i = 0; i < output_names_str_.size(); ++i)
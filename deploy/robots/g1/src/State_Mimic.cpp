@@ -4,6 +4,7 @@
 #include "isaaclab/envs/mdp/observations/observations.h"
 #include "isaaclab/envs/mdp/actions/joint_actions.h"
 #include "isaaclab/envs/mdp/terminations.h"
+#include "isaaclab/algorithms/policy_factory.h"
 
 static Eigen::Quaternionf init_quat;
 std::shared_ptr<State_Mimic::MotionLoader_> State_Mimic::motion = nullptr;
@@ -11,18 +12,36 @@ std::shared_ptr<State_Mimic::MotionLoader_> State_Mimic::motion = nullptr;
 namespace
 {
 
+// Set while load() builds the env, possibly on the FSM loader thread, so the motion terms evaluated by
+// ObservationManager see the loading state's motion without swapping the one used by an active state.
+thread_local std::shared_ptr<State_Mimic::MotionLoader_> loading_motion;
+
+// Points loading_motion at a state's motion for one scope, cleared on every exit path.
+struct LoadingMotionGuard
+{
+    explicit LoadingMotionGuard(std::shared_ptr<State_Mimic::MotionLoader_> motion) { loading_motion = std::move(motion); }
+    ~LoadingMotionGuard() { loading_motion.reset(); }
+    LoadingMotionGuard(const LoadingMotionGuard&) = delete;
+    LoadingMotionGuard& operator=(const LoadingMotionGuard&) = delete;
+};
+
+std::shared_ptr<State_Mimic::MotionLoader_>& current_motion()
+{
+    return loading_motion ? loading_motion : State_Mimic::motion;
+}
+
 Eigen::Quaternionf torso_quat_w(isaaclab::ManagerBasedRLEnv* env)
 {
     using G1Type = unitree::BaseArticulation<LowState_t::SharedPtr>;
     G1Type* robot = dynamic_cast<G1Type*>(env->robot.get());
 
     auto root_quat = env->robot->data.root_quat_w;
-    auto& motors = robot->lowstate->msg_.motor_state();
+    const auto& q = robot->state.q; // same snapshot as root_quat
 
     Eigen::Quaternionf torso_quat = root_quat
-        * Eigen::AngleAxisf(motors[12].q(), Eigen::Vector3f::UnitZ())
-        * Eigen::AngleAxisf(motors[13].q(), Eigen::Vector3f::UnitX())
-        * Eigen::AngleAxisf(motors[14].q(), Eigen::Vector3f::UnitY());
+        * Eigen::AngleAxisf(q[12], Eigen::Vector3f::UnitZ())
+        * Eigen::AngleAxisf(q[13], Eigen::Vector3f::UnitX())
+        * Eigen::AngleAxisf(q[14], Eigen::Vector3f::UnitY());
     return torso_quat;
 }
 
@@ -47,7 +66,7 @@ namespace mdp
 REGISTER_OBSERVATION(motion_joint_pos)
 {
     auto& robot = env->robot;
-    auto& loader = State_Mimic::motion;
+    auto& loader = current_motion();
     auto& ids = robot->data.joint_ids_map;
 
     auto data_dfs = loader->joint_pos();
@@ -62,7 +81,7 @@ REGISTER_OBSERVATION(motion_joint_pos)
 REGISTER_OBSERVATION(motion_joint_vel)
 {
     auto& robot = env->robot;
-    auto& loader = State_Mimic::motion;
+    auto& loader = current_motion();
     auto& ids = robot->data.joint_ids_map;
 
     auto data_dfs = loader->joint_vel();
@@ -77,7 +96,7 @@ REGISTER_OBSERVATION(motion_joint_vel)
 REGISTER_OBSERVATION(motion_command)
 {
     auto& robot = env->robot;
-    auto& loader = State_Mimic::motion;
+    auto& loader = current_motion();
     auto& ids = robot->data.joint_ids_map;
 
     auto pos_dfs = loader->joint_pos();
@@ -103,7 +122,7 @@ REGISTER_OBSERVATION(motion_command)
 REGISTER_OBSERVATION(motion_anchor_ori_b)
 {
     auto real_quat_w = torso_quat_w(env);
-    auto ref_quat_w = anchor_quat_w(State_Mimic::motion);
+    auto ref_quat_w = anchor_quat_w(current_motion());
 
     auto rot_ = (init_quat * ref_quat_w).conjugate() * real_quat_w;
     auto rot = rot_.toRotationMatrix().transpose();
@@ -120,11 +139,37 @@ State_Mimic::State_Mimic(int state_mode, std::string state_string)
     : FSMState(state_mode, std::move(state_string))
 {
     auto cfg = param::config["FSM"][getStateString()];
+    const std::string finished_state = cfg["finished_transition"]
+        ? cfg["finished_transition"].as<std::string>()
+        : "Velocity_Y";
+    if (!FSMStringMap.right.count(finished_state))
+    {
+        throw std::runtime_error("State_Mimic: unknown finished_transition target " + finished_state);
+    }
+    finished_state_id_ = FSMStringMap.right.at(finished_state);
+
+    this->registered_checks.emplace_back(
+        std::make_pair(
+            [&]() -> bool { return motion_finished_.load(); },
+            finished_state_id_
+        )
+    );
+    this->registered_checks.emplace_back(
+        std::make_pair(
+            [&]() -> bool { return isaaclab::mdp::bad_orientation(env_.get(), 1.0f); },
+            FSMStringMap.right.at("Passive")
+        )
+    );
+}
+
+void State_Mimic::load()
+{
+    const auto& cfg = state_cfg_;
     auto policy_dir = param::parser_policy_dir(cfg["policy_dir"].as<std::string>());
     const auto deploy_rel = cfg["deploy_yaml"] ? cfg["deploy_yaml"].as<std::string>() : "params/deploy.yaml";
     const auto onnx_rel = cfg["onnx_model"] ? cfg["onnx_model"].as<std::string>() : "exported/policy.onnx";
 
-    auto articulation = std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate);
+    auto articulation = std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate, FSMState::state_hub);
 
     std::filesystem::path motion_file = cfg["motion_file"].as<std::string>();
     if (!motion_file.is_absolute())
@@ -135,7 +180,6 @@ State_Mimic::State_Mimic(int state_mode, std::string state_string)
     motion_ = std::make_shared<MotionLoader_>(motion_file.string(), cfg["fps"].as<float>());
     spdlog::info("State_Mimic: loaded motion '{}' with duration {:.2f}s",
                  motion_file.stem().string(), motion_->duration);
-    motion = motion_;
 
     time_range_[0] = cfg["time_start"] && !cfg["time_start"].IsNull()
         ? std::clamp(cfg["time_start"].as<float>(), 0.0f, motion_->duration)
@@ -145,33 +189,16 @@ State_Mimic::State_Mimic(int state_mode, std::string state_string)
         : motion_->duration;
     reference_time_.store(time_range_[0]);
 
-    env_ = std::make_unique<isaaclab::ManagerBasedRLEnv>(
-        YAML::LoadFile((policy_dir / deploy_rel).string()),
-        articulation
-    );
-    env_->alg = std::make_unique<isaaclab::OrtRunner>((policy_dir / onnx_rel).string());
-
-    const std::string finished_state = cfg["finished_transition"]
-        ? cfg["finished_transition"].as<std::string>()
-        : "Velocity_Y";
-    if (!FSMStringMap.right.count(finished_state))
     {
-        throw std::runtime_error("State_Mimic: unknown finished_transition target " + finished_state);
+        LoadingMotionGuard guard(motion_);
+        env_ = std::make_unique<isaaclab::ManagerBasedRLEnv>(
+            YAML::LoadFile((policy_dir / deploy_rel).string()),
+            articulation
+        );
     }
-    finished_state_id_ = FSMStringMap.right.at(finished_state);
+    env_->alg = isaaclab::make_policy(policy_dir / onnx_rel, isaaclab::PolicyOptions::from(cfg, env_->cfg, policy_dir));
+    env_->alg->set_requested_outputs({"actions"});
 
-    this->registered_checks.emplace_back(
-        std::make_pair(
-            [&]() -> bool { return motion_finished_.load(); },
-            finished_state_id_
-        )
-    );
-    this->registered_checks.emplace_back(
-        std::make_pair(
-            [&]() -> bool { return isaaclab::mdp::bad_orientation(env_.get(), 1.0f); },
-            FSMStringMap.right.at("Passive")
-        )
-    );
 }
 
 void State_Mimic::enter()
@@ -235,7 +262,8 @@ void State_Mimic::run()
         return;
     }
 
-    auto action = env_->action_manager->processed_actions();
+    auto& action = processed_action_;
+    env_->action_manager->processed_actions_into(action);
     for (int i = 0; i < env_->robot->data.joint_ids_map.size(); ++i)
     {
         lowcmd->msg_.motor_cmd()[env_->robot->data.joint_ids_map[i]].q() = action[i];
@@ -14,13 +14,6 @@
 
 namespace
 {
-enum class OnnxExecProvider
-{
-    TensorRT,
-    CUDA,
-    CPU
-};
-
 constexpr std::array<int, 29> kPerm = {
     0, 3, 6, 9, 13, 17, 1, 4, 7, 10, 14, 18, 2, 5, 8, 11, 15, 19, 21, 23, 25, 27, 12, 16, 20, 22, 24, 26, 28
 };
@@ -29,81 +22,6 @@ constexpr std::array<int, 29> kInvPerm = {
     0, 6, 12, 1, 7, 13, 2, 8, 14, 3, 9, 15, 22, 4, 10, 16, 23, 5, 11, 17, 24, 18, 25, 19, 26, 20, 27, 21, 28
 };
 
-OnnxExecProvider append_best_provider(
-    Ort::SessionOptions& options,
-    int device_id,
-    bool enable_tensorrt,
-    bool enable_cuda,
-    bool trt_fp16_enable,
-    const std::string& trt_cache_path)
-{
-    const OrtApi& api = Ort::GetApi();
-
-    char** providers = nullptr;
-    int provider_count = 0;
-    OrtStatus* status = api.GetAvailableProviders(&providers, &provider_count);
-    if (status != nullptr)
-    {
-        spdlog::warn("State_OmniXtreme: GetAvailableProviders failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-        return OnnxExecProvider::CPU;
-    }
-
-    bool has_tensorrt = false;
-    bool has_cuda = false;
-    for (int i = 0; i < provider_count; ++i)
-    {
-        const std::string provider_name = providers[i];
-        if (provider_name == "TensorrtExecutionProvider")
-        {
-            has_tensorrt = true;
-        }
-        else if (provider_name == "CUDAExecutionProvider")
-        {
-            has_cuda = true;
-        }
-    }
-
-    OrtStatus* release_status = api.ReleaseAvailableProviders(providers, provider_count);
-    if (release_status != nullptr)
-    {
-        api.ReleaseStatus(release_status);
-    }
-
-    if (enable_tensorrt && has_tensorrt)
-    {
-        OrtTensorRTProviderOptions trt_options{};
-        trt_options.device_id = device_id;
-        trt_options.trt_max_partition_iterations = 1000;
-        trt_options.trt_min_subgraph_size = 1;
-        trt_options.trt_fp16_enable = trt_fp16_enable ? 1 : 0;
-        trt_options.trt_engine_cache_enable = trt_cache_path.empty() ? 0 : 1;
-        trt_options.trt_engine_cache_path = trt_cache_path.empty() ? nullptr : trt_cache_path.c_str();
-        status = api.SessionOptionsAppendExecutionProvider_TensorRT(options, &trt_options);
-        if (status == nullptr)
-        {
-            return OnnxExecProvider::TensorRT;
-        }
-        spdlog::warn("State_OmniXtreme: append TensorRT provider failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-    }
-
-    if (enable_cuda && has_cuda)
-    {
-        OrtCUDAProviderOptions cuda_options{};
-        cuda_options.device_id = device_id;
-        status = api.SessionOptionsAppendExecutionProvider_CUDA(options, &cuda_options);
-        if (status == nullptr)
-        {
-            return OnnxExecProvider::CUDA;
-        }
-        spdlog::warn("State_OmniXtreme: append CUDA provider failed: {}", api.GetErrorMessage(status));
-        api.ReleaseStatus(status);
-    }
-
-    return OnnxExecProvider::CPU;
-}
-
 std::vector<float> clamp_vec(const std::vector<float>& x, const std::vector<float>& lo, const std::vector<float>& hi)
 {
     std::vector<float> y = x;
@@ -195,7 +113,11 @@ State_OmniXtreme::State_OmniXtreme(int state_mode, std::string state_string)
     {
         throw std::runtime_error("State_OmniXtreme: missing config for state " + state_string);
     }
+}
 
+void State_OmniXtreme::load()
+{
+    const auto& cfg = state_cfg_;
     load_policy_and_env(cfg);
     initialize_limits(cfg);
     load_motion_library(cfg);
@@ -221,7 +143,7 @@ void State_OmniXtreme::load_policy_and_env(const YAML::Node& cfg)
     deploy_cfg_ = deploy_cfg;
     env_ = std::make_unique<isaaclab::ManagerBasedRLEnv>(
         deploy_cfg,
-        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate)
+        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate, FSMState::state_hub)
     );
 
     dof_ = env_->robot->data.joint_ids_map.size();
@@ -229,37 +151,27 @@ void State_OmniXtreme::load_policy_and_env(const YAML::Node& cfg)
     action_scale_ = require_vec(omni_cfg, "action_scale", dof_);
     obs_default_joint_pos_ = require_vec(omni_cfg, "pd_bias_joint_pos", dof_);
 
-    const bool prefer_cuda = cfg["onnx_cuda"] ? cfg["onnx_cuda"].as<bool>() : true;
-    const bool prefer_tensorrt = cfg["onnx_tensorrt"] ? cfg["onnx_tensorrt"].as<bool>() : true;
-    const int cuda_device_id = cfg["onnx_cuda_device"] ? cfg["onnx_cuda_device"].as<int>() : 0;
-    const bool trt_fp16_enable = cfg["onnx_trt_fp16"] ? cfg["onnx_trt_fp16"].as<bool>() : true;
-    const std::string trt_cache_dir =
-        cfg["onnx_trt_cache_dir"] ? cfg["onnx_trt_cache_dir"].as<std::string>() : "trt_cache";
-    const std::filesystem::path trt_cache_path =
-        trt_cache_dir.empty() ? std::filesystem::path() : (policy_dir_ / trt_cache_dir);
-    if (!trt_cache_path.empty())
-    {
-        std::filesystem::create_directories(trt_cache_path);
-    }
-
-    base_session_options_.SetGraphOptimizationLevel(ORT_ENABLE_EXTENDED);
-    residual_session_options_.SetGraphOptimizationLevel(ORT_ENABLE_EXTENDED);
-    const OnnxExecProvider base_provider = append_best_provider(
-        base_session_options_, cuda_device_id, prefer_tensorrt, prefer_cuda, trt_fp16_enable, trt_cache_path.string());
-    const OnnxExecProvider residual_provider = append_best_provider(
-        residual_session_options_, cuda_device_id, prefer_tensorrt, prefer_cuda, trt_fp16_enable, trt_cache_path.string());
-    Ort::SessionOptions fk_session_options;
-    fk_session_options.SetGraphOptimizationLevel(ORT_ENABLE_EXTENDED);
-    const OnnxExecProvider fk_provider = append_best_provider(
-        fk_session_options, cuda_device_id, prefer_tensorrt, prefer_cuda, trt_fp16_enable, trt_cache_path.string());
+    isaaclab::SessionConfig onnx_defaults;
+    onnx_defaults.providers = {"TensorRT", "CUDA", "CPU"};
+    onnx_defaults.trt_fp16 = true;
+    onnx_defaults.trt_cache_dir = "trt_cache";
+    const auto onnx_cfg = isaaclab::SessionConfig::from(cfg, onnx_defaults, policy_dir_);
+    std::string base_provider;
+    std::string residual_provider;
+    std::string fk_provider;
 
     const auto base_model_path = (policy_dir_ / base_model_rel).string();
     const auto residual_model_path = (policy_dir_ / residual_model_rel).string();
     const auto fk_model_path = (policy_dir_ / fk_model_rel).string();
+    auto& runtime = isaaclab::InferenceRuntime::instance();
+    const auto quantization = isaaclab::QuantizationConfig::from(cfg["quantization"]);
 
     spdlog::info("State_OmniXtreme: loading base model {}", base_model_path);
     auto t0 = clock::now();
-    base_session_ = std::make_unique<Ort::Session>(ort_env_, base_model_path.c_str(), base_session_options_);
+    base_session_ = runtime.create_session(
+        base_model_path, base_session_options_, "State_OmniXtreme/base", onnx_cfg, &base_provider);
+    base_session_ = isaaclab::quantize_session(
+        std::move(base_session_), base_model_path, "State_OmniXtreme/base", quantization, onnx_cfg, base_provider);
     auto t1 = clock::now();
     spdlog::info(
         "State_OmniXtreme: base model ready in {:.3f}s",
@@ -267,19 +179,38 @@ void State_OmniXtreme::load_policy_and_env(const YAML::Node& cfg)
 
     spdlog::info("State_OmniXtreme: loading residual model {}", residual_model_path);
     t0 = clock::now();
-    residual_session_ = std::make_unique<Ort::Session>(ort_env_, residual_model_path.c_str(), residual_session_options_);
+    residual_session_ = runtime.create_session(
+        residual_model_path, residual_session_options_, "State_OmniXtreme/residual", onnx_cfg, &residual_provider);
+    residual_session_ = isaaclab::quantize_session(
+        std::move(residual_session_), residual_model_path, "State_OmniXtreme/residual", quantization, onnx_cfg,
+        residual_provider);
     t1 = clock::now();
     spdlog::info(
         "State_OmniXtreme: residual model ready in {:.3f}s",
         std::chrono::duration<double>(t1 - t0).count());
 
-    spdlog::info("State_OmniXtreme: loading fk model {}", fk_model_path);
-    t0 = clock::now();
-    fk_session_ = std::make_unique<Ort::Session>(ort_env_, fk_model_path.c_str(), fk_session_options);
-    t1 = clock::now();
-    spdlog::info(
-        "State_OmniXtreme: fk model ready in {:.3f}s",
-        std::chrono::duration<double>(t1 - t0).count());
+    const bool analytic_fk = cfg["analytic_fk"] ? cfg["analytic_fk"].as<bool>() : false;
+    if (analytic_fk)
+    {
+        fk_chain_ = std::make_unique<isaaclab::KinematicChain>(
+            isaaclab::KinematicChain::from_yaml(cfg["fk_chain"], param::proj_dir.string()));
+    }
+    if (!analytic_fk || std::filesystem::exists(fk_model_path))
+    {
+        spdlog::info("State_OmniXtreme: loading fk model {}", fk_model_path);
+        t0 = clock::now();
+        Ort::SessionOptions fk_session_options;
+        fk_session_ = runtime.create_session(
+            fk_model_path, fk_session_options, "State_OmniXtreme/fk", onnx_cfg, &fk_provider);
+        t1 = clock::now();
+        spdlog::info(
+            "State_OmniXtreme: fk model ready in {:.3f}s",
+            std::chrono::duration<double>(t1 - t0).count());
+    }
+    else
+    {
+        spdlog::warn("State_OmniXtreme: fk model {} not found, using analytic fk without parity check", fk_model_path);
+    }
 
     for (std::size_t i = 0; i < base_session_->GetInputCount(); ++i)
     {
@@ -331,34 +262,37 @@ void State_OmniXtreme::load_policy_and_env(const YAML::Node& cfg)
         residual_action_output_name_ = residual_output_names_str_.front();
     }
 
-    auto log_provider = [](const char* model_name, OnnxExecProvider provider) {
-        if (provider == OnnxExecProvider::TensorRT)
+    auto log_provider = [&onnx_cfg](const char* model_name, const std::string& provider) {
+        if (provider == "CPU" && (onnx_cfg.has_provider("TensorRT") || onnx_cfg.has_provider("CUDA")))
         {
-            spdlog::info("State_OmniXtreme: {} execution provider: TensorRT", model_name);
-        }
-        else if (provider == OnnxExecProvider::CUDA)
-        {
-            spdlog::info("State_OmniXtreme: {} execution provider: CUDA", model_name);
+            spdlog::warn("State_OmniXtreme: {} execution provider fallback to CPU", model_name);
         }
         else
         {
-            spdlog::warn("State_OmniXtreme: {} execution provider fallback to CPU", model_name);
+            spdlog::info("State_OmniXtreme: {} execution provider: {}", model_name, provider);
         }
     };
     log_provider("base model", base_provider);
     log_provider("residual model", residual_provider);
-    log_provider("fk model", fk_provider);
-
-    for (std::size_t i = 0; i < fk_session_->GetOutputCount(); ++i)
+    if (fk_session_)
     {
-        auto name = fk_session_->GetOutputNameAllocated(i, allocator_);
-        fk_output_names_str_.push_back(name.get());
+        log_provider("fk model", fk_provider);
+
+        for (std::size_t i = 0; i < fk_session_->GetOutputCount(); ++i)
+        {
+            auto name = fk_session_->GetOutputNameAllocated(i, allocator_);
+            fk_output_names_str_.push_back(name.get());
+        }
+        fk_output_names_.clear();
+        fk_output_names_.reserve(fk_output_names_str_.size());
+        for (const auto& name : fk_output_names_str_)
+        {
+            fk_output_names_.push_back(name.c_str());
+        }
     }
-    fk_output_names_.clear();
-    fk_output_names_.reserve(fk_output_names_str_.size());
-    for (const auto& name : fk_output_names_str_)
+    if (fk_chain_ && fk_session_)
     {
-        fk_output_names_.push_back(name.c_str());
+        verify_analytic_fk(cfg["fk_parity_tol"] ? cfg["fk_parity_tol"].as<float>() : 1e-3f);
     }
 
     for (std::size_t i = 0; i < base_input_names_str_.size(); ++i)
@@ -379,6 +313,12 @@ void State_OmniXtreme::load_policy_and_env(const YAML::Node& cfg)
     }
     history_length_ = std::max<std::size_t>(1, history_obs_dim_ / std::max<std::size_t>(1, real_obs_dim_));
     residual_obs_dim_ = real_obs_dim_ + command_obs_dim_ + dof_;
+
+    if (cfg["async_inference"] && cfg["async_inference"].as<bool>())
+    {
+        inference_worker_ = std::make_unique<isaaclab::InferenceWorker>();
+        spdlog::info("State_OmniXtreme: async inference enabled");
+    }
 }
 
 void State_OmniXtreme::initialize_limits(const YAML::Node& cfg)
@@ -612,6 +552,7 @@ void State_OmniXtreme::enter()
         double base_time_ms_sum = 0.0;
         double residual_time_ms_sum = 0.0;
         double step_time_ms_sum = 0.0;
+        double saved_time_ms_sum = 0.0; // critical-path time hidden behind the worker (async_inference)
         std::size_t timing_count = 0;
 
         while (policy_thread_running_)
@@ -621,15 +562,54 @@ void State_OmniXtreme::enter()
 
             const auto& traj = trajectories_[trajectory_index_];
             const std::size_t obs_frame_index = execute_motion_ ? frame_index_ : paused_frame_index();
-            const auto fk_t0 = clock::now();
-            auto command_obs = build_command_obs(traj, obs_frame_index);
-            const auto fk_t1 = clock::now();
-            auto real_obs = build_real_obs({});
-            auto history_obs = build_history_obs(real_obs);
-            const auto base_t0 = clock::now();
-            auto base_action = infer_base_action(real_obs, command_obs, history_obs);
-            const auto base_t1 = clock::now();
-            auto residual_obs = build_residual_obs(real_obs, command_obs, base_action);
+            std::vector<float> command_obs;
+            std::vector<float> real_obs;
+            std::vector<float> history_obs;
+            std::vector<float> base_action;
+            std::vector<float> residual_obs;
+            std::vector<float> q_low;
+            std::vector<float> q_high;
+            std::vector<float> tau_ff;
+            double fk_ms = 0.0;
+            double base_ms = 0.0;
+            if (inference_worker_)
+            {
+                // FK runs on the worker while the real obs / history are assembled here; the base model then
+                // runs on the worker while the residual obs (up to the base action) and torque limits are built.
+                inference_worker_->submit([&] { command_obs = build_command_obs(traj, obs_frame_index); });
+                auto overlap_t0 = clock::now();
+                real_obs = build_real_obs({});
+                history_obs = build_history_obs(real_obs);
+                double overlap_ms = std::chrono::duration<double, std::milli>(clock::now() - overlap_t0).count();
+                inference_worker_->wait();
+                fk_ms = inference_worker_->job_ms();
+                saved_time_ms_sum += std::min(overlap_ms, fk_ms);
+
+                inference_worker_->submit([&] { base_action = infer_base_action(real_obs, command_obs, history_obs); });
+                overlap_t0 = clock::now();
+                residual_obs = build_residual_obs(real_obs, command_obs, std::vector<float>(dof_, 0.0f));
+                compute_torque_limits(q_low, q_high, tau_ff);
+                overlap_ms = std::chrono::duration<double, std::milli>(clock::now() - overlap_t0).count();
+                inference_worker_->wait();
+                base_ms = inference_worker_->job_ms();
+                saved_time_ms_sum += std::min(overlap_ms, base_ms);
+                set_residual_base_action(residual_obs, base_action);
+            }
+            else
+            {
+                const auto fk_t0 = clock::now();
+                command_obs = build_command_obs(traj, obs_frame_index);
+                const auto fk_t1 = clock::now();
+                real_obs = build_real_obs({});
+                history_obs = build_history_obs(real_obs);
+                const auto base_t0 = clock::now();
+                base_action = infer_base_action(real_obs, command_obs, history_obs);
+                const auto base_t1 = clock::now();
+                residual_obs = build_residual_obs(real_obs, command_obs, base_action);
+                compute_torque_limits(q_low, q_high, tau_ff);
+                fk_ms = std::chrono::duration<double, std::milli>(fk_t1 - fk_t0).count();
+                base_ms = std::chrono::duration<double, std::milli>(base_t1 - base_t0).count();
+            }
             const auto residual_t0 = clock::now();
             auto residual_action = infer_residual_action(residual_obs);
             const auto residual_t1 = clock::now();
@@ -641,28 +621,9 @@ void State_OmniXtreme::enter()
             }
 
             auto q_target = compute_q_target(final_action);
-            std::vector<float> tau_ff(dof_, 0.0f);
-            const float v_eps = 1e-2f;
-            const auto& joint_pos = env_->robot->data.joint_pos;
-            const auto& joint_vel = env_->robot->data.joint_vel;
             for (std::size_t i = 0; i < dof_; ++i)
             {
-                const float dq = joint_vel[i];
-                const float abs_dq = std::abs(dq);
-                const float over = std::max(abs_dq - x1_[i], 0.0f);
-                const float base_pos = abs_dq <= v_eps ? y2_[i] : (dq >= 0.0f ? y1_[i] : y2_[i]);
-                const float base_neg = abs_dq <= v_eps ? -y2_[i] : (dq >= 0.0f ? -y2_[i] : -y1_[i]);
-                const float denom = std::max(x2_[i] - x1_[i], 1e-6f);
-                const float tau_high = std::max(base_pos - (base_pos / denom) * over, 0.0f);
-                const float tau_low = std::min(base_neg + ((-base_neg) / denom) * over, 0.0f);
-
-                const float p_limits_low = tau_low + d_gains_[i] * dq;
-                const float p_limits_high = tau_high + d_gains_[i] * dq;
-                const float q_low = p_limits_low / p_gains_[i] + joint_pos[i];
-                const float q_high = p_limits_high / p_gains_[i] + joint_pos[i];
-                q_target[i] = std::clamp(q_target[i], q_low, q_high);
-
-                tau_ff[i] = -(fs_[i] * std::tanh(dq / va_[i]) + fd_[i] * dq);
+                q_target[i] = std::clamp(q_target[i], q_low[i], q_high[i]);
             }
             {
                 std::lock_guard<std::mutex> lock(target_mtx_);
@@ -680,8 +641,8 @@ void State_OmniXtreme::enter()
                 latest_tau_ff_ = std::move(tau_ff);
             }
 
-            fk_time_ms_sum += std::chrono::duration<double, std::milli>(fk_t1 - fk_t0).count();
-            base_time_ms_sum += std::chrono::duration<double, std::milli>(base_t1 - base_t0).count();
+            fk_time_ms_sum += fk_ms;
+            base_time_ms_sum += base_ms;
             residual_time_ms_sum += std::chrono::duration<double, std::milli>(residual_t1 - residual_t0).count();
             step_time_ms_sum += std::chrono::duration<double, std::milli>(clock::now() - step_t0).count();
             ++timing_count;
@@ -697,15 +658,17 @@ void State_OmniXtreme::enter()
             if (timing_count % 200 == 0)
             {
                 spdlog::info(
-                    "State_OmniXtreme step={} traj={} running={} avg_fk_ms={:.3f} avg_base_ms={:.3f} avg_res_ms={:.3f} avg_step_ms={:.3f}",
+                    "State_OmniXtreme step={} traj={} running={} avg_fk_ms={:.3f} avg_base_ms={:.3f} avg_res_ms={:.3f} avg_step_ms={:.3f}{}",
                     total_steps_,
                     trajectories_[trajectory_index_].name,
                     execute_motion_.load(),
                     fk_time_ms_sum / static_cast<double>(timing_count),
                     base_time_ms_sum / static_cast<double>(timing_count),
                     residual_time_ms_sum / static_cast<double>(timing_count),
-                    step_time_ms_sum / static_cast<double>(timing_count));
+                    step_time_ms_sum / static_cast<double>(timing_count),
+                    inference_worker_ ? fmt::format(" avg_overlap_saved_ms={:.3f}", saved_time_ms_sum / static_cast<double>(timing_count)) : "");
                 fk_time_ms_sum = 0.0;
+                saved_time_ms_sum = 0.0;
                 base_time_ms_sum = 0.0;
                 residual_time_ms_sum = 0.0;
                 step_time_ms_sum = 0.0;
@@ -856,7 +819,6 @@ std::vector<float> State_OmniXtreme::build_command_obs(const MotionTrajectory& t
     const auto& ref_joint_vel = traj.ref_joint_vel_frames[idx];
     const auto& ref_anchor_quat = traj.ref_anchor_quat_frames[idx];
 
-    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
     std::array<float, 3> joint_angles = {
         env_->robot->data.joint_pos[12],
         env_->robot->data.joint_pos[13],
@@ -872,6 +834,25 @@ std::vector<float> State_OmniXtreme::build_command_obs(const MotionTrajectory& t
         adjusted_root_quat.y(),
         adjusted_root_quat.z()
     };
+    const Eigen::Quaternionf current_anchor_quat = fk_chain_
+        ? fk_chain_->forward(Eigen::Vector3f(base_pos.data()), adjusted_root_quat, joint_angles.data()).quat
+        : onnx_fk_anchor_quat(joint_angles, base_pos, base_quat);
+    Eigen::Quaternionf relative_quat = current_anchor_quat.conjugate() * ref_anchor_quat;
+    relative_quat.normalize();
+    const auto anchor_6d = quat_to_6d(relative_quat);
+
+    std::vector<float> command_obs;
+    command_obs.reserve(command_obs_dim_);
+    command_obs.insert(command_obs.end(), ref_joint_pos.begin(), ref_joint_pos.end());
+    command_obs.insert(command_obs.end(), ref_joint_vel.begin(), ref_joint_vel.end());
+    command_obs.insert(command_obs.end(), anchor_6d.begin(), anchor_6d.end());
+    return command_obs;
+}
+
+Eigen::Quaternionf State_OmniXtreme::onnx_fk_anchor_quat(
+    std::array<float, 3>& joint_angles, std::array<float, 3>& base_pos, std::array<float, 4>& base_quat)
+{
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
     std::array<int64_t, 2> shape3 = {1, 3};
     std::array<int64_t, 2> shape4 = {1, 4};
 
@@ -889,6 +870,7 @@ std::vector<float> State_OmniXtreme::build_command_obs(const MotionTrajectory& t
         fk_input_tensors.size(),
         fk_output_names_.data(),
         fk_output_names_.size());
+    isaaclab::InferenceRuntime::instance().profile_step(*fk_session_);
 
     if (fk_outputs.size() < 2)
     {
@@ -896,18 +878,52 @@ std::vector<float> State_OmniXtreme::build_command_obs(const MotionTrajectory& t
     }
 
     const float* rot_data = fk_outputs[1].GetTensorMutableData<float>();
-    Eigen::Quaternionf current_anchor_quat = wxyz_to_eigen_quat(rot_data);
-    current_anchor_quat.normalize();
-    Eigen::Quaternionf relative_quat = current_anchor_quat.conjugate() * ref_anchor_quat;
-    relative_quat.normalize();
-    const auto anchor_6d = quat_to_6d(relative_quat);
+    Eigen::Quaternionf anchor_quat = wxyz_to_eigen_quat(rot_data);
+    anchor_quat.normalize();
+    return anchor_quat;
+}
 
-    std::vector<float> command_obs;
-    command_obs.reserve(command_obs_dim_);
-    command_obs.insert(command_obs.end(), ref_joint_pos.begin(), ref_joint_pos.end());
-    command_obs.insert(command_obs.end(), ref_joint_vel.begin(), ref_joint_vel.end());
-    command_obs.insert(command_obs.end(), anchor_6d.begin(), anchor_6d.end());
-    return command_obs;
+// Compare the analytic chain against the fk model on random waist angles and base orientations.
+// On success the fk session is released; otherwise the analytic chain is dropped.
+void State_OmniXtreme::verify_analytic_fk(float tol)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr int kSamples = 256;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> angle(-1.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    float max_err = 0.0f;
+    double onnx_us = 0.0;
+    double analytic_us = 0.0;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        std::array<float, 3> joint_angles = {angle(rng), angle(rng), angle(rng)};
+        std::array<float, 3> base_pos = {0.0f, 0.0f, 0.79f};
+        const Eigen::Quaternionf q = Eigen::Quaternionf(normal(rng), normal(rng), normal(rng), normal(rng)).normalized();
+        std::array<float, 4> base_quat = {q.w(), q.x(), q.y(), q.z()};
+
+        const auto t0 = clock::now();
+        const Eigen::Quaternionf expected = onnx_fk_anchor_quat(joint_angles, base_pos, base_quat);
+        const auto t1 = clock::now();
+        const Eigen::Quaternionf actual = fk_chain_->forward(Eigen::Vector3f(base_pos.data()), q, joint_angles.data()).quat;
+        const auto t2 = clock::now();
+
+        max_err = std::max(max_err, expected.angularDistance(actual));
+        onnx_us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        analytic_us += std::chrono::duration<double, std::micro>(t2 - t1).count();
+    }
+
+    spdlog::info(
+        "State_OmniXtreme: analytic fk parity max_err_rad={:.2e} (tol {:.1e}) avg_onnx_us={:.1f} avg_analytic_us={:.2f}",
+        max_err, tol, onnx_us / kSamples, analytic_us / kSamples);
+    if (max_err > tol)
+    {
+        spdlog::error("State_OmniXtreme: analytic fk does not match the fk model, keeping the fk model");
+        fk_chain_.reset();
+        return;
+    }
+    fk_session_.reset();
 }
 
 std::vector<float> State_OmniXtreme::build_residual_obs(
@@ -1039,6 +1055,7 @@ std::vector<float> State_OmniXtreme::infer_base_action(
         input_tensors.size(),
         base_output_names_.data(),
         base_output_names_.size());
+    isaaclab::InferenceRuntime::instance().profile_step(*base_session_);
 
     for (std::size_t i = 0; i < base_output_names_str_.size(); ++i)
     {
@@ -1072,6 +1089,7 @@ std::vector<float> State_OmniXtreme::infer_residual_action(const std::vector<flo
         1,
         residual_output_names_.data(),
         residual_output_names_.size());
+    isaaclab::InferenceRuntime::instance().profile_step(*residual_session_);
 
     for (std::size_t i = 0; i < residual_output_names_str_.size(); ++i)
     {
@@ -1098,6 +1116,45 @@ std::vector<float> State_OmniXtreme::infer_residual_action(const std::vector<flo
     return out;
 }
 
+void State_OmniXtreme::set_residual_base_action(std::vector<float>& residual_obs, const std::vector<float>& base_action) const
+{
+    // base_action is the last block of build_residual_obs()
+    const std::size_t offset = residual_obs.size() - dof_;
+    for (std::size_t j = 0; j < dof_; ++j)
+    {
+        residual_obs[offset + j] = base_action[kInvPerm[j]];
+    }
+}
+
+void State_OmniXtreme::compute_torque_limits(
+    std::vector<float>& q_low, std::vector<float>& q_high, std::vector<float>& tau_ff) const
+{
+    q_low.assign(dof_, 0.0f);
+    q_high.assign(dof_, 0.0f);
+    tau_ff.assign(dof_, 0.0f);
+    const float v_eps = 1e-2f;
+    const auto& joint_pos = env_->robot->data.joint_pos;
+    const auto& joint_vel = env_->robot->data.joint_vel;
+    for (std::size_t i = 0; i < dof_; ++i)
+    {
+        const float dq = joint_vel[i];
+        const float abs_dq = std::abs(dq);
+        const float over = std::max(abs_dq - x1_[i], 0.0f);
+        const float base_pos = abs_dq <= v_eps ? y2_[i] : (dq >= 0.0f ? y1_[i] : y2_[i]);
+        const float base_neg = abs_dq <= v_eps ? -y2_[i] : (dq >= 0.0f ? -y2_[i] : -y1_[i]);
+        const float denom = std::max(x2_[i] - x1_[i], 1e-6f);
+        const float tau_high = std::max(base_pos - (base_pos / denom) * over, 0.0f);
+        const float tau_low = std::min(base_neg + ((-base_neg) / denom) * over, 0.0f);
+
+        const float p_limits_low = tau_low + d_gains_[i] * dq;
+        const float p_limits_high = tau_high + d_gains_[i] * dq;
+        q_low[i] = p_limits_low / p_gains_[i] + joint_pos[i];
+        q_high[i] = p_limits_high / p_gains_[i] + joint_pos[i];
+
+        tau_ff[i] = -(fs_[i] * std::tanh(dq / va_[i]) + fd_[i] * dq);
+    }
+}
+
 std::vector<float> State_OmniXtreme::compute_q_target(const std::vector<float>& action) const
 {
     std::vector<float> q(dof_, 0.0f);
@@ -2,6 +2,7 @@
 #include "unitree_articulation.h"
 #include "isaaclab/envs/mdp/observations/observations.h"
 #include "isaaclab/envs/mdp/actions/joint_actions.h"
+#include "isaaclab/algorithms/inference_graph.h"
 #include <unordered_map>
 
 namespace isaaclab
@@ -35,15 +36,6 @@ REGISTER_OBSERVATION(keyboard_velocity_commands)
 State_RLBase::State_RLBase(int state_mode, std::string state_string)
 : FSMState(state_mode, state_string) 
 {
-    auto cfg = param::config["FSM"][state_string];
-    auto policy_dir = param::parser_policy_dir(cfg["policy_dir"].as<std::string>());
-
-    env = std::make_unique<isaaclab::ManagerBasedRLEnv>(
-        YAML::LoadFile(policy_dir / "params" / "deploy.yaml"),
-        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate)
-    );
-    env->alg = std::make_unique<isaaclab::OrtRunner>(policy_dir / "exported" / "policy.onnx");
-
     this->registered_checks.emplace_back(
         std::make_pair(
             [&]()->bool{ return isaaclab::mdp::bad_orientation(env.get(), 1.0); },
@@ -52,9 +44,32 @@ State_RLBase::State_RLBase(int state_mode, std::string state_string)
     );
 }
 
+void State_RLBase::load()
+{
+    const auto& cfg = state_cfg_;
+    auto policy_dir = param::parser_policy_dir(cfg["policy_dir"].as<std::string>());
+
+    env = std::make_unique<isaaclab::ManagerBasedRLEnv>(
+        YAML::LoadFile(policy_dir / "params" / "deploy.yaml"),
+        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate, FSMState::state_hub)
+    );
+    env->alg = isaaclab::make_policy_from_dir(policy_dir, env->cfg, isaaclab::PolicyOptions::from(cfg, env->cfg, policy_dir));
+    env->check_action_output();
+    if (cfg["adaptive_inference"] && env->action_manager->chunked()) {
+        spdlog::warn("State_RLBase: adaptive_inference is ignored for action-chunk policies.");
+    } else {
+        env->adaptive_inference = isaaclab::AdaptiveInference::from(cfg["adaptive_inference"], env->step_dt);
+    }
+    env->alg->set_requested_outputs({"actions"});
+}
+
 void State_RLBase::run()
 {
-    auto action = env->action_manager->processed_actions();
+    if (env->action_manager->chunked()) {
+        env->action_manager->apply_chunk(std::chrono::steady_clock::now());
+    }
+    auto & action = processed_action_;
+    env->action_manager->processed_actions_into(action);
     for(int i(0); i < env->robot->data.joint_ids_map.size(); i++) {
         lowcmd->msg_.motor_cmd()[env->robot->data.joint_ids_map[i]].q() = action[i];
     }
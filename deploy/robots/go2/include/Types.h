@@ -1,6 +1,8 @@
 #pragma once
 
 #include "unitree/dds_wrapper/robots/go2/go2.h"
+#include "robot_state_hub.h"
 
 using LowCmd_t = unitree::robot::go2::publisher::LowCmd;
 using LowState_t = unitree::robot::go2::subscription::LowState;
+using RobotStateHub_t = unitree::RobotStateHub<LowState_t::SharedPtr>;
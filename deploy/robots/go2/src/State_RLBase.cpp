@@ -2,6 +2,7 @@
 #include "unitree_articulation.h"
 #include "isaaclab/envs/mdp/observations/observations.h"
 #include "isaaclab/envs/mdp/actions/joint_actions.h"
+#include "isaaclab/algorithms/inference_graph.h"
 
 State_RLBase::State_RLBase(int state_mode, std::string state_string)
 : FSMState(state_mode, state_string) 
@@ -14,20 +15,32 @@ State_RLBase::State_RLBase(int state_mode, std::string state_string)
         return;
     }
 
-    auto policy_dir = param::parser_policy_dir(cfg["policy_dir"].as<std::string>());
-
-    env = std::make_unique<isaaclab::ManagerBasedRLEnv>(
-        YAML::LoadFile(policy_dir / "params" / "deploy.yaml"),
-        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate)
-    );
-    env->alg = std::make_unique<isaaclab::OrtRunner>(policy_dir / "exported" / "policy.onnx");
-
     this->registered_checks.emplace_back(
         std::make_pair(
             [&]()->bool{ return isaaclab::mdp::bad_orientation(env.get(), 2.0); },
             FSMStringMap.right.at("Passive")
         )
     );
+}
+
+void State_RLBase::load()
+{
+    const auto& cfg = state_cfg_;
+    if (!cfg["policy_dir"] || cfg["policy_dir"].IsNull()) return; // disabled
+
+    auto policy_dir = param::parser_policy_dir(cfg["policy_dir"].as<std::string>());
+
+    env = std::make_unique<isaaclab::ManagerBasedRLEnv>(
+        YAML::LoadFile(policy_dir / "params" / "deploy.yaml"),
+        std::make_shared<unitree::BaseArticulation<LowState_t::SharedPtr>>(FSMState::lowstate, FSMState::state_hub)
+    );
+    env->alg = isaaclab::make_policy_from_dir(policy_dir, env->cfg, isaaclab::PolicyOptions::from(cfg, env->cfg, policy_dir));
+    env->check_action_output();
+    if (cfg["adaptive_inference"] && env->action_manager->chunked()) {
+        spdlog::warn("State_RLBase: adaptive_inference is ignored for action-chunk policies.");
+    } else {
+        env->adaptive_inference = isaaclab::AdaptiveInference::from(cfg["adaptive_inference"], env->step_dt);
+    }
 
     // Initialize logger
     if (cfg["logging"] && cfg["logging"].as<bool>()) {
@@ -52,6 +65,13 @@ State_RLBase::State_RLBase(int state_mode, std::string state_string)
         last_log_time = start_time - std::chrono::duration_cast<std::chrono::steady_clock::duration>(logging_dt);
     }
 
+    // Only read back the outputs that are consumed
+    if (enable_logging) {
+        env->alg->set_requested_outputs({"actions", "weights", "latent"});
+    } else {
+        env->alg->set_requested_outputs({"actions"});
+    }
+
     // Initialize fixed command settings
     if (cfg["fixed_command"] && cfg["fixed_command"]["enabled"]) {
         env->fixed_command_enabled = cfg["fixed_command"]["enabled"].as<bool>();
@@ -103,7 +123,11 @@ void State_RLBase::run()
         }
     }
 
-    auto action = env->action_manager->processed_actions();
+    if (env->action_manager->chunked()) {
+        env->action_manager->apply_chunk(std::chrono::steady_clock::now());
+    }
+    auto & action = processed_action_;
+    env->action_manager->processed_actions_into(action);
     for(int i(0); i < env->robot->data.joint_ids_map.size(); i++) {
         lowcmd->msg_.motor_cmd()[env->robot->data.joint_ids_map[i]].q() = action[i];
     }
@@ -131,32 +155,24 @@ void State_RLBase::run()
             logger->add("wall_time", ss_wall.str());
 
             logger->add("q_des", action);
-            std::vector<float> q, dq, tau, temp;
-            for (int i(0); i < 12; ++i) {
-                q.push_back(lowstate->msg_.motor_state()[i].q());
-                dq.push_back(lowstate->msg_.motor_state()[i].dq());
-                tau.push_back(lowstate->msg_.motor_state()[i].tau_est());
-                temp.push_back(lowstate->msg_.motor_state()[i].temperature());
-            }
+            const auto state = state_hub->read();
+            std::vector<float> q(state.q.begin(), state.q.begin() + 12);
+            std::vector<float> dq(state.dq.begin(), state.dq.begin() + 12);
+            std::vector<float> tau(state.tau_est.begin(), state.tau_est.begin() + 12);
+            std::vector<float> temp(state.temperature.begin(), state.temperature.begin() + 12);
             logger->add("q", q);
             logger->add("dq", dq);
             logger->add("tau", tau);
             logger->add("temp", temp);
 
-            std::vector<float> rpy(3), acc(3), gyro(3);
-            for (int i(0); i < 3; ++i) {
-                rpy[i] = lowstate->msg_.imu_state().rpy()[i];
-                acc[i] = lowstate->msg_.imu_state().accelerometer()[i];
-                gyro[i] = lowstate->msg_.imu_state().gyroscope()[i];
-            }
+            std::vector<float> rpy(state.rpy.begin(), state.rpy.end());
+            std::vector<float> acc(state.acc.begin(), state.acc.end());
+            std::vector<float> gyro(state.gyro.begin(), state.gyro.end());
             logger->add("imu_rpy", rpy);
             logger->add("imu_acc", acc);
             logger->add("ang_vel", gyro);
 
-            std::vector<float> foot_force(4);
-            for (int i(0); i < 4; ++i) {
-                foot_force[i] = lowstate->msg_.foot_force()[i];
-            }
+            std::vector<float> foot_force(state.foot_force.begin(), state.foot_force.end());
             logger->add("foot_force", foot_force);
 
             std::vector<float> foot_contacts(4);
@@ -0,0 +1,366 @@
+// Copyright (c) 2025, Unitree Robotics Co., Ltd.
+// All rights reserved.
+
+// Offline check of exported policies: model I/O, size, estimated FLOPs, latency under the configured backend
+// and threads, and deploy.yaml obs/action dims against the model. Runs without a robot connection.
+//
+//   policy_inspect ../../../logs/g1/velocity                 # resolves exported/ like param::parser_policy_dir
+//   policy_inspect -r ../../../logs/go2                      # every policy directory below logs/go2
+//   policy_inspect --state Velocity                          # policy_dir and session options of a config.yaml state
+//
+// Exits with 1 when a dimension check or a benchmark failed.
+
+#include "param.h"
+#include "isaaclab/algorithms/inference_graph.h"
+#include "isaaclab/algorithms/onnx_model.h"
+#include <algorithm>
+#include <spdlog/fmt/fmt.h>
+#include <iostream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct DeployDims
+{
+    std::map<std::string, long> groups; // obs group -> size, -1 when a term has no per-element scale
+    long action_dim = -1;
+};
+
+// Observation layout as ObservationManager builds it; a term's size is the length of its `scale` list.
+DeployDims deploy_dims(const YAML::Node& cfg)
+{
+    DeployDims dims;
+    auto group_dim = [](const YAML::Node& group) {
+        long total = 0;
+        for (const auto& kv : group) {
+            const auto key = kv.first.as<std::string>();
+            if (key == "use_gym_history" || key == "scale_first" || key == "history_order") continue;
+            const auto& term = kv.second;
+            if (!term["scale"] || !term["scale"].IsSequence()) return -1L;
+            total += static_cast<long>(term["scale"].size()) * term["history_length"].as<int>(1);
+        }
+        return total;
+    };
+
+    const auto obs = cfg["observations"];
+    if (obs && obs.IsMap()) {
+        bool flat = false;
+        for (const auto& kv : obs) {
+            const auto key = kv.first.as<std::string>();
+            if (key == "use_gym_history" || key == "scale_first" || key == "history_order") continue;
+            flat = kv.second["params"].IsDefined();
+            break;
+        }
+        if (flat) {
+            dims.groups["obs"] = group_dim(obs);
+        } else {
+            for (const auto& kv : obs) {
+                const auto key = kv.first.as<std::string>();
+                if (key == "use_gym_history" || key == "scale_first" || key == "history_order") continue;
+                dims.groups[key] = group_dim(kv.second);
+            }
+        }
+    }
+
+    const auto actions = cfg["actions"];
+    if (actions && actions.IsMap()) {
+        dims.action_dim = 0;
+        for (const auto& kv : actions) {
+            const auto& term = kv.second;
+            if (term["scale"] && term["scale"].IsSequence()) dims.action_dim += term["scale"].size();
+            else if (term["joint_ids"] && term["joint_ids"].IsSequence()) dims.action_dim += term["joint_ids"].size();
+            else if (cfg["joint_ids_map"]) dims.action_dim += cfg["joint_ids_map"].size();
+            else { dims.action_dim = -1; break; }
+        }
+    }
+    return dims;
+}
+
+std::string shape_str(const std::vector<int64_t>& shape)
+{
+    std::string s = "[";
+    for (size_t i = 0; i < shape.size(); ++i) s += (i ? ", " : "") + (shape[i] < 0 ? std::string("?") : std::to_string(shape[i]));
+    return s + "]";
+}
+
+// Elements of the static part of a shape (symbolic dims count as 1).
+long static_size(const std::vector<int64_t>& shape)
+{
+    long size = 1;
+    for (auto d : shape) size *= d > 0 ? d : 1;
+    return size;
+}
+
+std::string human(double value)
+{
+    if (value >= 1e9) return fmt::format("{:.2f}G", value / 1e9);
+    if (value >= 1e6) return fmt::format("{:.2f}M", value / 1e6);
+    if (value >= 1e3) return fmt::format("{:.1f}K", value / 1e3);
+    return fmt::format("{:.0f}", value);
+}
+
+// Multiply-adds of MatMul / Gemm / pointwise Conv against constant weights, one row per input (batch 1).
+double estimate_flops(const isaaclab::onnx::Model& model)
+{
+    double flops = 0.0;
+    for (const auto& node : model.nodes) {
+        if (node.op_type == "Conv" && node.inputs.size() >= 2) {
+            // Pointwise (grouped) Conv as NativeRunner runs it: weight [cout, cin / group, 1...], one position
+            auto it = model.initializers.find(node.inputs[1]);
+            if (it == model.initializers.end() || it->second.dims.size() < 2) continue;
+            const auto& d = it->second.dims;
+            if (std::any_of(d.begin() + 2, d.end(), [](int64_t k) { return k != 1; })) continue;
+            const double cout = static_cast<double>(d[0]), cin_g = static_cast<double>(d[1]);
+            flops += 2.0 * cout * cin_g;
+            if (node.inputs.size() > 2) flops += cout;
+            continue;
+        }
+        if ((node.op_type != "MatMul" && node.op_type != "Gemm") || node.inputs.size() < 2) continue;
+        auto it = model.initializers.find(node.inputs[1]);
+        if (it == model.initializers.end() || it->second.dims.size() < 2) continue;
+        const auto& d = it->second.dims;
+        const double k = static_cast<double>(d[d.size() - 2]);
+        const double n = static_cast<double>(d[d.size() - 1]);
+        double batch = 1.0;
+        for (size_t i = 0; i + 2 < d.size(); ++i) batch *= d[i];
+        flops += 2.0 * k * n * batch;
+        if (node.op_type == "Gemm" && node.inputs.size() > 2) flops += n;
+    }
+    return flops;
+}
+
+// OrtRunner keeps `x_in` / `x_out` pairs as recurrent state, they are not observations.
+bool is_state_input(const std::string& name, const isaaclab::onnx::Model& model)
+{
+    const auto pos = name.find("_in");
+    if (pos == std::string::npos) return false;
+    std::string out = name;
+    out.replace(pos, 3, "_out");
+    for (const auto& o : model.outputs) if (o.name == out) return true;
+    return false;
+}
+
+class Inspector
+{
+public:
+    Inspector(YAML::Node state_cfg, int iterations) : state_cfg_(std::move(state_cfg)), iterations_(iterations) {}
+
+    void policy_dir(const fs::path& dir)
+    {
+        std::cout << "\n== " << dir.string() << "\n";
+        const fs::path deploy_path = fs::exists(dir / "params" / "deploy.yaml") ? dir / "params" / "deploy.yaml" : dir / "param" / "deploy.yaml";
+        YAML::Node deploy_cfg;
+        if (fs::exists(deploy_path)) {
+            deploy_cfg = YAML::LoadFile(deploy_path.string());
+        } else {
+            std::cout << "  (no params/deploy.yaml, dimension checks skipped)\n";
+        }
+        const auto dims = deploy_dims(deploy_cfg);
+        const auto opts = isaaclab::PolicyOptions::from(state_cfg_, deploy_cfg, dir);
+        for (const auto& [group, size] : dims.groups) {
+            std::cout << fmt::format("  deploy.yaml obs group '{}': {}\n", group, size < 0 ? "?" : std::to_string(size));
+        }
+        if (dims.action_dim >= 0) std::cout << fmt::format("  deploy.yaml action dim: {}\n", dims.action_dim);
+
+        std::set<fs::path> models;
+        const fs::path model_dir = fs::exists(dir / "exported") ? dir / "exported" : dir; // BFM / OmniXtreme keep models in policy_dir
+        for (const auto& entry : fs::directory_iterator(model_dir)) {
+            if (entry.path().extension() == ".onnx") models.insert(entry.path());
+        }
+        const bool graph = deploy_cfg["inference_graph"].IsDefined();
+        if (graph) {
+            for (const auto& stage : deploy_cfg["inference_graph"]["stages"]) {
+                if (stage["model"]) models.insert(dir / stage["model"].as<std::string>());
+            }
+        }
+        for (const auto& model : models) {
+            const bool main_policy = !graph && model.filename() == "policy.onnx";
+            this->model(model, opts, main_policy ? &dims : nullptr);
+        }
+
+        if (graph) {
+            std::cout << "  inference_graph:\n";
+            try {
+                auto policy = isaaclab::make_policy_from_dir(dir, deploy_cfg, opts);
+                std::unordered_map<std::string, std::vector<float>> obs;
+                for (const auto& [group, size] : dims.groups) obs[group].assign(std::max(size, 1L), 0.0f);
+                _benchmark(*policy, obs, dims.action_dim);
+            } catch (const std::exception& e) {
+                fail(fmt::format("inference_graph failed: {}", e.what()));
+            }
+        }
+    }
+
+    void fail(const std::string& msg)
+    {
+        std::cout << "    FAIL " << msg << "\n";
+        ++failures_;
+    }
+
+    int failures() const { return failures_; }
+
+private:
+    void model(const fs::path& path, const isaaclab::PolicyOptions& opts, const DeployDims* dims)
+    {
+        std::cout << "  " << path.filename().string() << " (" << human(static_cast<double>(fs::file_size(path))) << "B)\n";
+
+        isaaclab::onnx::Model model;
+        try {
+            model = isaaclab::onnx::load(path.string());
+        } catch (const std::exception& e) {
+            fail(e.what());
+            return;
+        }
+        double params = 0.0;
+        for (const auto& [name, t] : model.initializers) params += static_cast<double>(t.data.size());
+        std::cout << fmt::format("    opset {}, {} nodes, {} parameters, ~{} FLOPs/step (MatMul/Gemm)\n",
+            model.opset, model.nodes.size(), human(params), human(estimate_flops(model)));
+
+        std::unordered_map<std::string, std::vector<float>> obs;
+        for (const auto& input : model.inputs) {
+            const bool state = is_state_input(input.name, model);
+            std::cout << fmt::format("    in  {:<24} {}{}\n", input.name, shape_str(input.shape), state ? " (recurrent state)" : "");
+            if (!state) obs[input.name].assign(static_size(input.shape), 0.0f);
+        }
+        for (const auto& output : model.outputs) {
+            std::cout << fmt::format("    out {:<24} {}\n", output.name, shape_str(output.shape));
+        }
+
+        if (dims) _check_dims(model, *dims, obs);
+
+        try {
+            auto policy = isaaclab::make_policy(path, opts);
+            _benchmark(*policy, obs, -1);
+        } catch (const std::exception& e) {
+            fail(fmt::format("benchmark failed: {}", e.what()));
+        }
+    }
+
+    // deploy.yaml groups feed the inputs of the same name (or the only input); actions size the first output.
+    void _check_dims(const isaaclab::onnx::Model& model, const DeployDims& dims,
+                     std::unordered_map<std::string, std::vector<float>>& obs)
+    {
+        for (auto& [name, buffer] : obs) {
+            auto group = dims.groups.find(name);
+            if (group == dims.groups.end() && obs.size() == 1 && dims.groups.size() == 1) group = dims.groups.begin();
+            if (group == dims.groups.end() || group->second < 0) continue;
+
+            const auto& input = *std::find_if(model.inputs.begin(), model.inputs.end(), [&](const auto& i) { return i.name == name; });
+            const long expected = static_size(input.shape);
+            const bool symbolic = std::any_of(input.shape.begin(), input.shape.end(), [](int64_t d) { return d < 0; });
+            // Symbolic dims absorb a multiple of the static part (batch, history length)
+            const bool ok = symbolic ? group->second % expected == 0 : group->second == expected;
+            if (ok) {
+                std::cout << fmt::format("    ok  obs '{}' ({}) -> {}\n", group->first, group->second, name);
+                buffer.assign(group->second, 0.0f);
+            } else {
+                fail(fmt::format("obs '{}' has {} values, input {} expects {}", group->first, group->second, name, shape_str(input.shape)));
+            }
+        }
+
+        if (dims.action_dim < 0 || model.outputs.empty()) return;
+        auto output = std::find_if(model.outputs.begin(), model.outputs.end(), [](const auto& o) { return o.name == "actions"; });
+        if (output == model.outputs.end()) output = model.outputs.begin();
+        const long size = static_size(output->shape);
+        if (size == dims.action_dim) {
+            std::cout << fmt::format("    ok  actions ({}) <- {}\n", dims.action_dim, output->name);
+        } else {
+            fail(fmt::format("action dim {} but output {} is {}", dims.action_dim, output->name, shape_str(output->shape)));
+        }
+    }
+
+    void _benchmark(isaaclab::Algorithms& policy, const std::unordered_map<std::string, std::vector<float>>& obs, long action_dim)
+    {
+        const auto latency = isaaclab::detail::measure_latency(policy, obs, iterations_);
+        std::cout << fmt::format("    latency p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us ({} steps)\n",
+            latency.p50_us, latency.p99_us, latency.max_us, iterations_);
+        const auto action = policy.get_action();
+        if (action_dim >= 0 && static_cast<long>(action.size()) != action_dim) {
+            fail(fmt::format("graph produced {} actions, deploy.yaml expects {}", action.size(), action_dim));
+        }
+    }
+
+    YAML::Node state_cfg_;
+    int iterations_;
+    int failures_ = 0;
+};
+
+// Policy directories below `root` (any directory with an exported/ folder).
+std::vector<fs::path> find_policy_dirs(const fs::path& root)
+{
+    std::vector<fs::path> dirs;
+    if (fs::exists(root / "exported")) dirs.push_back(root);
+    for (auto it = fs::recursive_directory_iterator(root); it != fs::recursive_directory_iterator(); ++it) {
+        if (it->is_directory() && fs::exists(it->path() / "exported")) {
+            dirs.push_back(it->path());
+            it.disable_recursion_pending();
+        }
+    }
+    std::sort(dirs.begin(), dirs.end());
+    return dirs;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+    po::options_description desc("policy_inspect [options] [policy_dir ...]");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("state,s", po::value<std::string>(), "use the policy_dir and session options of this config.yaml FSM state")
+        ("recursive,r", "inspect every policy directory below the given paths")
+        ("iterations,i", po::value<int>()->default_value(1000), "benchmark steps per model")
+        ("path", po::value<std::vector<std::string>>(), "policy directories")
+        ;
+    po::positional_options_description positional;
+    positional.add("path", -1);
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+    po::notify(vm);
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    param::bin_path = param::get_bin_path();
+    param::load_config_file();
+    spdlog::set_level(spdlog::level::warn);
+    isaaclab::InferenceRuntime::instance().configure(param::config["inference"]);
+
+    YAML::Node state_cfg;
+    std::vector<fs::path> paths;
+    if (vm.count("path")) {
+        for (const auto& p : vm["path"].as<std::vector<std::string>>()) paths.push_back(fs::absolute(p));
+    }
+    if (vm.count("state")) {
+        state_cfg = param::config["FSM"][vm["state"].as<std::string>()];
+        if (!state_cfg) {
+            std::cerr << "state " << vm["state"].as<std::string>() << " not found in config.yaml\n";
+            return 1;
+        }
+        // Relative to the project directory, as for g1_ctrl / go2_ctrl
+        if (paths.empty() && state_cfg["policy_dir"]) paths.push_back(param::proj_dir / state_cfg["policy_dir"].as<std::string>());
+    }
+    if (paths.empty()) {
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    Inspector inspector(state_cfg, vm["iterations"].as<int>());
+    for (const auto& root : paths) {
+        const auto dirs = vm.count("recursive") ? find_policy_dirs(root) : std::vector<fs::path>{param::parser_policy_dir(root)};
+        for (const auto& dir : dirs) {
+            try {
+                inspector.policy_dir(dir);
+            } catch (const std::exception& e) {
+                inspector.fail(fmt::format("{}: {}", dir.string(), e.what()));
+            }
+        }
+    }
+    std::cout << "\n" << (inspector.failures() ? fmt::format("{} check(s) failed\n", inspector.failures()) : std::string("all checks passed\n"));
+    return inspector.failures() ? 1 : 0;
+}